@@ -0,0 +1,130 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <fftw3.h>
+#include <gio/gio.h>
+#include <glib.h>
+#include <sys/types.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+enum class TapPoint { input, output };
+
+/*
+  Spectrum analyzer tap. The plugin it is attached to copies the mono downmix of its input or output buffers into the
+  ring buffer from the realtime thread. No graph node is created for it.
+
+  There is a single writer and the reader does not lock. A read that overlaps a write may mix samples of two adjacent
+  quanta. That is harmless for a spectrum display and keeps the realtime side wait free.
+*/
+
+class AnalyzerTap {
+ public:
+  static constexpr size_t capacity = 8192U;  // same size used by the Spectrum FFT
+
+  static_assert((capacity & (capacity - 1U)) == 0U);
+
+  void write(std::span<const float> left, std::span<const float> right);
+
+  // Copies the most recent output.size() samples. output can not be larger than capacity
+
+  void read_latest(std::span<float> output) const;
+
+  std::atomic<uint> rate = 0U;
+
+  // The worker thread does not analyze a disabled tap. Used while the spectrum is hidden
+
+  std::atomic<bool> enabled = true;
+
+ private:
+  std::array<float, capacity> ring{};
+
+  std::atomic<size_t> write_position = 0U;  // total number of samples written
+};
+
+/*
+  All the taps are analyzed by one worker thread owned by this class. It wakes up once every meters update interval,
+  computes the spectrum of each registered tap and hands the result to the tap callback. The callbacks run in the
+  worker thread.
+*/
+
+class AnalyzerTaps {
+ public:
+  AnalyzerTaps();
+  AnalyzerTaps(const AnalyzerTaps&) = delete;
+  auto operator=(const AnalyzerTaps&) -> AnalyzerTaps& = delete;
+  AnalyzerTaps(const AnalyzerTaps&&) = delete;
+  auto operator=(const AnalyzerTaps&&) -> AnalyzerTaps& = delete;
+  ~AnalyzerTaps();
+
+  using Callback = std::function<void(uint, uint, const std::vector<double>&)>;  // rate, nbands, magnitudes
+
+  // Registering a tap again replaces its callback
+
+  void add(const std::shared_ptr<AnalyzerTap>& tap, Callback callback);
+
+  // When this returns the callback of the tap is not running and will not be called again
+
+  void remove(const std::shared_ptr<AnalyzerTap>& tap);
+
+  [[nodiscard]] auto get_memory_usage() const -> size_t;
+
+ private:
+  GSettings* settings = nullptr;
+
+  std::vector<gulong> gconnections;
+
+  std::atomic<int> interval_ms = 100;
+
+  bool exiting = false;
+
+  struct Entry {
+    std::shared_ptr<AnalyzerTap> tap;
+
+    Callback callback;
+  };
+
+  std::vector<Entry> entries;
+
+  mutable std::mutex mutex;
+
+  std::condition_variable cv;
+
+  fftwf_plan plan = nullptr;
+
+  fftwf_complex* complex_output = nullptr;
+
+  std::vector<float> real_input, window;
+
+  std::vector<double> output;
+
+  std::thread thread;
+
+  void run();
+};
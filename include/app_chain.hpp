@@ -0,0 +1,79 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <cstdint>
+#include <map>
+#include <string>
+#include "effects_base.hpp"
+#include "pipe_manager.hpp"
+#include "pipe_objects.hpp"
+
+/*
+  Effects chain of the applications assigned to it in the "app-chains" key of the output pipeline. These apps play to
+  a sink of their own. The sink output goes through the chain plugins and is mixed with the main pipeline in the
+  output device. A chain only exists while one of its applications has a stream.
+*/
+
+class AppChain : public EffectsBase {
+ public:
+  AppChain(std::string key, PipeManager* pipe_manager);
+  AppChain(const AppChain&) = delete;
+  auto operator=(const AppChain&) -> AppChain& = delete;
+  AppChain(const AppChain&&) = delete;
+  auto operator=(const AppChain&&) -> AppChain& = delete;
+  ~AppChain() override;
+
+  // application id or node name used in the assignment
+
+  const std::string key;
+
+  // Its id is invalid until PipeManager::app_chain_sink_added is emitted for it
+
+  NodeInfo sink;
+
+  // node ids of the streams playing to the chain by serial
+
+  std::map<uint64_t, uint> streams;
+
+  // Used in the GSettings path and in the node names. Only lowercase letters, digits and dashes are kept
+
+  static auto make_id(const std::string& key) -> std::string;
+
+  static auto make_schema_path(const std::string& key) -> std::string;
+
+  void set_sink(const NodeInfo& node_info);
+
+  void set_bypass(const bool& state);
+
+ private:
+  bool bypass = false;
+
+  void connect_filters(const bool& bypass = false);
+
+  void disconnect_filters();
+
+  auto get_chain_source_id() -> uint override;
+
+  auto get_chain_sink_id() -> uint override;
+
+  void relink_filters() override;
+};
@@ -27,6 +27,8 @@
 #include <glibconfig.h>
 #include <sigc++/connection.h>
 #include <vector>
+#include "analyzer_taps.hpp"
+#include "meters_export.hpp"
 #include "pipe_manager.hpp"
 #include "presets_manager.hpp"
 #include "stream_input_effects.hpp"
@@ -47,6 +49,10 @@ struct Data {
   std::vector<sigc::connection> connections;
 
   std::vector<gulong> gconnections, gconnections_sie, gconnections_soe;
+
+  guint memory_timeout_id = 0U;
+
+  bool over_memory_budget = false;
 };
 
 struct _Application {
@@ -57,6 +63,9 @@ struct _Application {
   GSettings* sie_settings;
 
   PipeManager* pm;
+  MetersExport* meters_export;
+
+  AnalyzerTaps* analyzer_taps;
   StreamOutputEffects* soe;
   StreamInputEffects* sie;
   PresetsManager* presets_manager;
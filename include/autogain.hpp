@@ -22,10 +22,12 @@
 #include <ebur128.h>
 #include <sigc++/signal.h>
 #include <sys/types.h>
+#include <cstddef>
 #include <span>
 #include <string>
 #include <thread>
 #include <vector>
+#include "param_block.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 
@@ -61,6 +63,8 @@ class AutoGain : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  auto count_memory_usage() -> size_t override;
+
   sigc::signal<void(const double,  // loudness
                     const double,  // gain
                     const double,  // momentary
@@ -82,11 +86,16 @@ class AutoGain : public PluginBase {
 
   uint old_rate = 0U;
 
-  double target = -23.0;  // target loudness level
-  double silence_threshold = -70.0;
   double internal_output_gain = 1.0;
 
-  Reference reference = Reference::geometric_mean_msi;
+  struct Params {
+    double target = -23.0;  // target loudness level
+    double silence_threshold = -70.0;
+
+    Reference reference = Reference::geometric_mean_msi;
+  };
+
+  ParamBlock<Params> params;
 
   std::vector<float> data;
 
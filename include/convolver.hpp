@@ -21,6 +21,7 @@
 
 #include <sys/types.h>
 #include <zita-convolver.h>
+#include <cstddef>
 #include <deque>
 #include <span>
 #include <string>
@@ -52,6 +53,10 @@ class Convolver : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  auto count_memory_usage() -> size_t override;
+
+  void release_caches() override;
+
   bool do_autogain = false;
 
   const std::string irs_ext = ".irs";
@@ -23,6 +23,7 @@
 #include <span>
 #include <string>
 #include <vector>
+#include "param_block.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 
@@ -49,6 +50,15 @@ class Crossfeed : public PluginBase {
   auto get_latency_seconds() -> float override;
 
  private:
+  struct Params {
+    int fcut = 0;
+    int feed = 0;
+  };
+
+  ParamBlock<Params> params;
+
+  Params applied;  // values bs2b is currently using. Only touched by the realtime thread
+
   std::vector<float> data;
 
   bs2b_base bs2b;
@@ -22,6 +22,7 @@
 #include <sys/types.h>
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <deque>
 #include <memory>
 #include <span>
@@ -55,6 +56,8 @@ class Crystalizer : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  auto count_memory_usage() -> size_t override;
+
  private:
   bool n_samples_is_power_of_2 = true;
   bool filters_are_ready = false;
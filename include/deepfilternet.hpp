@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <span>
 #include <string>
@@ -50,6 +51,8 @@ class DeepFilterNet : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  auto count_memory_usage() -> size_t override;
+
  private:
   std::unique_ptr<ladspa::LadspaWrapper> ladspa_wrapper;
 
@@ -0,0 +1,63 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <atomic>
+#include <cstdint>
+#include <span>
+
+/*
+  Lowers the level of the output pipeline and of the application chains while voice is detected in the input pipeline.
+  The voice activity comes from the RNNoise and Speex plugins with voice activity detection enabled. They report it
+  from the input realtime thread and the output realtime threads read it, so everything happens inside the DSP graph
+  without going through the main thread or the PipeWire volume controls.
+
+  A report older than voice_timeout is ignored. This way the output does not stay ducked if the input pipeline stops
+  or the plugin reporting voice is removed.
+*/
+
+class Ducker {
+ public:
+  static constexpr int64_t voice_timeout_ms = 250;
+
+  // Called from the realtime thread of the input pipeline
+
+  static void set_voice_detected(const bool& state);
+
+  [[nodiscard]] static auto voice_detected() -> bool;
+
+  void setup(const uint& rate);
+
+  void process(std::span<float> left, std::span<float> right);
+
+  std::atomic<bool> enabled = false;
+
+  std::atomic<float> reduction_db = -15.0F, attack_ms = 20.0F, release_ms = 500.0F;
+
+ private:
+  inline static std::atomic<bool> voice_state = false;
+
+  inline static std::atomic<int64_t> voice_time_ms = 0;  // steady clock time of the last report
+
+  uint rate = 0U;
+
+  float gain = 1.0F;
+};
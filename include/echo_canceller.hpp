@@ -21,11 +21,13 @@
 
 #include <speex/speex_echo.h>
 #include <climits>
+#include <cstddef>
 #include <span>
 #include <string>
 #include <vector>
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
+#include "probe_aligner.hpp"
 
 #include <speex/speex_preprocess.h>
 #include <speex/speexdsp_config_types.h>
@@ -55,6 +57,8 @@ class EchoCanceller : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  auto count_memory_usage() -> size_t override;
+
  private:
   bool notify_latency = false;
   bool ready = false;
@@ -78,6 +82,8 @@ class EchoCanceller : public PluginBase {
 
   SpeexPreprocessState *state_left = nullptr, *state_right = nullptr;
 
+  ProbeAligner probe_aligner;
+
   void free_speex();
 
   void init_speex();
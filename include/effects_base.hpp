@@ -24,10 +24,12 @@
 #include <pipewire/proxy.h>
 #include <sigc++/connection.h>
 #include <sigc++/signal.h>
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
+#include "analyzer_taps.hpp"
 #include "autogain.hpp"
 #include "bass_enhancer.hpp"
 #include "bass_loudness.hpp"
@@ -59,15 +61,27 @@
 #include "speex.hpp"
 #include "stereo_tools.hpp"
 
+class PresetStage;
+
 class EffectsBase {
  public:
-  EffectsBase(std::string tag, const std::string& schema, PipeManager* pipe_manager, PipelineType pipe_type);
+  // schema_path is only needed by relocatable schemas
+
+  EffectsBase(std::string tag,
+              const std::string& schema,
+              PipeManager* pipe_manager,
+              PipelineType pipe_type,
+              const std::string& schema_path = "");
   EffectsBase(const EffectsBase&) = delete;
   auto operator=(const EffectsBase&) -> EffectsBase& = delete;
   EffectsBase(const EffectsBase&&) = delete;
   auto operator=(const EffectsBase&&) -> EffectsBase& = delete;
   virtual ~EffectsBase();
 
+  // Owned by the application. It analyzes the spectrum taps of both pipelines
+
+  inline static AnalyzerTaps* analyzer_taps = nullptr;
+
   const std::string log_tag;
 
   PipeManager* pm = nullptr;
@@ -110,6 +124,12 @@ class EffectsBase {
 
   sigc::signal<void(const float&)> pipeline_latency;
 
+  auto broadcast_memory_usage() -> size_t;
+
+  void release_caches();
+
+  sigc::signal<void(const size_t&)> memory_usage;
+
   auto get_plugins_map() -> std::map<std::string, std::shared_ptr<PluginBase>>;
 
   template <typename T>
@@ -117,6 +137,23 @@ class EffectsBase {
     return std::dynamic_pointer_cast<T>(plugins[name]);
   }
 
+  /*
+    Gapless preset switch used when "preset-crossfade-time" is not zero. The preset is loaded into a staging copy of
+    this pipeline that plays in parallel with it and the two are crossfaded. The preset is written to this pipeline
+    while it is silent and after its filters settle the crossfade is reversed. The filters present in both the old and
+    the new preset keep their state. A preset requested while a switch is running is applied after it.
+  */
+
+  void crossfade_to_preset(const std::string& preset_file);
+
+  // The preset has to be written to the pipeline at base_path. An empty base_path means this pipeline
+
+  sigc::signal<bool(const std::string preset_file, const std::string base_path)> apply_preset;
+
+  // The preset of a crossfade could not be written to this pipeline
+
+  sigc::signal<void(const std::string preset_file)> preset_failed;
+
  protected:
   GSettings *settings = nullptr, *global_settings = nullptr;
 
@@ -126,17 +163,91 @@ class EffectsBase {
 
   std::vector<pw_proxy*> list_proxies, list_proxies_listen_mic;
 
+  size_t last_memory_usage = 0U;
+
   std::vector<sigc::connection> connections;
 
   std::vector<gulong> gconnections, gconnections_global;
 
+  /*
+    The "spectrum-tap" key is "" for the end of the pipeline or "<plugin name>:input" and "<plugin name>:output". The
+    tap lives as long as this class so the plugins realtime threads can never write to a destroyed one.
+  */
+
+  std::shared_ptr<AnalyzerTap> spectrum_tap = std::make_shared<AnalyzerTap>();
+
+  void update_spectrum_tap();
+
   void create_filters_if_necessary();
 
   void remove_unused_filters();
 
+  // The links are kept. Only the scheduling of the filters stops. They have to be called with the PipeWire lock held
+
   void activate_filters();
 
   void deactivate_filters();
 
   void broadcast_pipeline_latency();
+
+  // True for the last node of the preset staging chain. Its links to this pipeline belong to the stage
+
+  [[nodiscard]] auto is_preset_stage_node(const uint& node_id) const -> bool;
+
+  /*
+    Bypassed plugins are left out of the links so they cost neither a node wakeup nor copies. They stay connected to
+    PipeWire, inactive, and keep their state. When the bypass of a linked plugin changes only the links around it are
+    replaced. The subclasses say where the chain of plugins starts and ends. When the source is SPA_ID_INVALID the
+    chain is not linked in the usual way and the whole pipeline is relinked instead.
+  */
+
+  [[nodiscard]] virtual auto get_chain_source_id() -> uint;
+
+  [[nodiscard]] virtual auto get_chain_sink_id() -> uint;
+
+  virtual void relink_filters();
+
+  // A suspended pipeline keeps its links but its filters stay inactive until it is resumed
+
+  [[nodiscard]] virtual auto is_suspended() -> bool;
+
+  // Called after the links around a plugin whose bypass changed were updated
+
+  virtual void on_filters_bypass_changed();
+
+  // Makes the bypassed plugins inactive and the others active. It has to be called after the links are made
+
+  void update_filters_activity();
+
+  /*
+    Splits the linked plugins in runs of consecutive plugins with lookahead and tells each plugin its part in the run.
+    See PluginBase::set_shared_lookahead. It has to be called after the links are made
+  */
+
+  void update_shared_lookahead();
+
+ private:
+  enum class CrossfadeState { idle, warmup, to_stage, settle, to_pipeline };
+
+  CrossfadeState crossfade_state = CrossfadeState::idle;
+
+  std::unique_ptr<PresetStage> preset_stage;
+
+  std::string crossfade_preset_file, pending_preset_file;
+
+  float crossfade_seconds = 0.0F;
+
+  guint crossfade_timeout_id = 0U;
+
+  void crossfade_step();
+
+  void apply_preset_to_pipeline(const std::string& preset_file);
+
+  void schedule_crossfade_step(const uint& delay_ms);
+
+  void on_plugin_bypass_changed(const std::string& name, const bool& state);
+
+  // Only the main pipelines export their spectrum. The preset stage would overwrite the area of its pipeline
+
+  void set_export_spectrum(const bool& state);
 };
@@ -39,6 +39,10 @@ auto create() -> EqualizerBandBox*;
 
 void setup(EqualizerBandBox* self, GSettings* settings);
 
+// Only the boxes visible in the list view are bound. Recycled boxes are bound again to a different band
+
 void bind(EqualizerBandBox* self, int index);
 
+void unbind(EqualizerBandBox* self);
+
 }  // namespace ui::equalizer_band_box
@@ -21,6 +21,7 @@
 
 #include <gio/gio.h>
 #include <nlohmann/json_fwd.hpp>
+#include <string>
 #include "plugin_preset_base.hpp"
 #include "preset_type.hpp"
 
@@ -33,6 +34,8 @@ class EqualizerPreset : public PluginPresetBase {
   auto operator=(const EqualizerPreset&&) -> EqualizerPreset& = delete;
   ~EqualizerPreset() override;
 
+  void relocate(const std::string& base_path) override;
+
  private:
   GSettings *input_settings_left = nullptr, *input_settings_right = nullptr, *output_settings_left = nullptr,
             *output_settings_right = nullptr;
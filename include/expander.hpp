@@ -22,6 +22,7 @@
 #include <pipewire/proxy.h>
 #include <sigc++/signal.h>
 #include <sys/types.h>
+#include <array>
 #include <span>
 #include <string>
 #include <vector>
@@ -64,6 +65,15 @@ class Expander : public PluginBase {
  private:
   uint latency_n_frames = 0U;
 
+  static constexpr std::array<const char*, 8U> meter_port_symbols = {
+      "rlm_l", "rlm_r", "slm_l", "slm_r", "clm_l", "clm_r", "elm_l", "elm_r"};
+
+  uint latency_port_index = lv2::Lv2Wrapper::invalid_port_index;
+
+  std::array<uint, meter_port_symbols.size()> meter_ports{};
+
+  std::array<float, meter_port_symbols.size()> meter_port_values{};
+
   std::vector<pw_proxy*> list_proxies;
 
   void update_sidechain_links(const std::string& key);
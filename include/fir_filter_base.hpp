@@ -22,6 +22,7 @@
 #include <sys/types.h>
 #include <zita-convolver.h>
 #include <algorithm>
+#include <cstddef>
 #include <span>
 #include <string>
 #include <vector>
@@ -50,6 +51,8 @@ class FirFilterBase {
 
   [[nodiscard]] auto get_delay() const -> float;
 
+  [[nodiscard]] auto get_memory_usage() const -> size_t;
+
   template <typename T1>
   void process(T1& data_left, T1& data_right) {
     std::span conv_left_in(conv->inpdata(0), n_samples);
@@ -22,12 +22,14 @@
 #include <ebur128.h>
 #include <sigc++/signal.h>
 #include <sys/types.h>
+#include <cstddef>
 #include <span>
 #include <string>
 #include <thread>
 #include <vector>
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
+#include "true_peak_detector.hpp"
 
 class LevelMeter : public PluginBase {
  public:
@@ -51,6 +53,8 @@ class LevelMeter : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  auto count_memory_usage() -> size_t override;
+
   void reset_history();
 
   sigc::signal<void(const double,  // momentary
@@ -81,6 +85,8 @@ class LevelMeter : public PluginBase {
 
   ebur128_state* ebur_state = nullptr;
 
+  TruePeakDetector true_peak;
+
   std::vector<std::thread> mythreads;
 
   auto init_ebur128() -> bool;
@@ -69,6 +69,18 @@ struct Port {
   bool optional;  // True if the connection is optional
 };
 
+/*
+  Loading all the installed LV2 bundles is the most expensive part of our startup. It is done only once in a worker
+  thread started by preload_world() so that it overlaps with the connection to PipeWire. The world is shared by all
+  wrappers and it is only used from the main thread after get_world() returns.
+*/
+
+void preload_world();
+
+auto get_world() -> LilvWorld*;
+
+void free_world();
+
 class Lv2Wrapper {
  public:
   Lv2Wrapper(const std::string& plugin_uri);
@@ -110,6 +122,30 @@ class Lv2Wrapper {
 
   auto get_control_port_value(const std::string& symbol) -> float;
 
+  /*
+    Meters should be read through port indices resolved once when the plugin is created. This way the realtime thread
+    copies the values without comparing port symbols.
+  */
+
+  static constexpr uint invalid_port_index = std::numeric_limits<uint>::max();
+
+  auto get_control_port_index(const std::string& symbol) -> uint;
+
+  [[nodiscard]] auto get_control_port_value(const uint& index) const -> float;
+
+  void get_control_port_values(std::span<const uint> indices, std::span<float> values) const;
+
+  template <size_t N>
+  auto get_control_port_indices(const std::array<const char*, N>& symbols) -> std::array<uint, N> {
+    std::array<uint, N> indices{};
+
+    for (size_t n = 0U; n < N; n++) {
+      indices[n] = get_control_port_index(symbols[n]);
+    }
+
+    return indices;
+  }
+
   auto has_instance() -> bool;
 
   void load_ui();
@@ -0,0 +1,220 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <gio/gio.h>
+#include <glib.h>
+#include <sys/types.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "pipeline_type.hpp"
+
+/*
+  Layout of the shared memory region where the level meters and the spectrum are published. It only uses fixed size
+  types so that external applications can map it without linking to anything from Easy Effects.
+
+  The region is a memfd. While the export is enabled the file $XDG_RUNTIME_DIR/easyeffects/meters contains the path
+  that has to be opened (/proc/<pid>/fd/<fd>). Consumers should map it read-only and read each slot with the seqlock
+  protocol implemented in read_slot/read_spectrum: an odd sequence number means the writer is in the middle of an
+  update and the copy has to be retried if the sequence changed while it was being made.
+*/
+
+namespace meters_export {
+
+inline constexpr uint32_t magic = 0x45454d54U;  // "EEMT"
+
+inline constexpr uint32_t version = 1U;
+
+inline constexpr uint32_t max_slots = 128U;
+
+inline constexpr uint32_t max_label_size = 48U;
+
+inline constexpr uint32_t max_values = 8U;
+
+inline constexpr uint32_t max_spectrum_bins = 4097U;
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+struct Slot {
+  std::atomic<uint32_t> sequence;
+
+  uint32_t in_use;
+
+  uint32_t pipeline;  // 0 for output and 1 for input
+
+  uint32_t n_values;
+
+  uint64_t timestamp;  // CLOCK_MONOTONIC nanoseconds
+
+  std::array<char, max_label_size> label;  // e.g. "compressor#0" or "appchains/firefox/gate#0", always null terminated
+
+  std::array<float, 2> input_level;  // dB, left and right
+
+  std::array<float, 2> output_level;  // dB, left and right
+
+  std::array<float, max_values> values;  // plugin specific values. See the plugin's sigc signal for their meaning
+};
+
+struct Spectrum {
+  std::atomic<uint32_t> sequence;
+
+  uint32_t rate;
+
+  uint32_t n_bins;
+
+  uint32_t padding;
+
+  uint64_t timestamp;  // CLOCK_MONOTONIC nanoseconds
+
+  // linear power of n_bins equally spaced bins from 0 to rate / 2. Not updated while the analyzer is logarithmic
+
+  std::array<float, max_spectrum_bins> bins;
+};
+
+struct Layout {
+  uint32_t magic;
+
+  uint32_t version;
+
+  uint32_t n_slots;
+
+  uint32_t n_spectrum;
+
+  std::array<Slot, max_slots> slots;
+
+  std::array<Spectrum, 2> spectrum;  // indexed like Slot::pipeline
+};
+
+template <typename T>
+auto read_seqlock(const T& src, T& dst) -> bool {
+  const auto begin = src.sequence.load(std::memory_order_acquire);
+
+  if ((begin & 1U) != 0U) {
+    return false;
+  }
+
+  // std::atomic can not be copied. Everything after the sequence counter is copied as raw bytes
+
+  const auto* src_bytes = reinterpret_cast<const std::byte*>(&src) + sizeof(src.sequence);
+  auto* dst_bytes = reinterpret_cast<std::byte*>(&dst) + sizeof(dst.sequence);
+
+  std::copy(src_bytes, src_bytes + sizeof(T) - sizeof(src.sequence), dst_bytes);
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  return src.sequence.load(std::memory_order_relaxed) == begin;
+}
+
+inline auto read_slot(const Layout& layout, const uint32_t& index, Slot& slot, const uint& max_tries = 16U) -> bool {
+  for (uint n = 0U; n < max_tries; n++) {
+    if (read_seqlock(layout.slots.at(index), slot)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+inline auto read_spectrum(const Layout& layout,
+                          const PipelineType& pipeline,
+                          Spectrum& spectrum,
+                          const uint& max_tries = 16U) -> bool {
+  const auto index = (pipeline == PipelineType::output) ? 0U : 1U;
+
+  for (uint n = 0U; n < max_tries; n++) {
+    if (read_seqlock(layout.spectrum.at(index), spectrum)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace meters_export
+
+class MetersExport {
+ public:
+  MetersExport();
+  MetersExport(const MetersExport&) = delete;
+  auto operator=(const MetersExport&) -> MetersExport& = delete;
+  MetersExport(const MetersExport&&) = delete;
+  auto operator=(const MetersExport&&) -> MetersExport& = delete;
+  ~MetersExport();
+
+  [[nodiscard]] auto is_enabled() const -> bool;
+
+  /*
+    Slots are handed out in the main thread. A negative value means that all slots are taken. The slot index is
+    stable for the whole life of the plugin even if the export is disabled and enabled again.
+  */
+
+  auto acquire_slot(const PipelineType& pipeline, const std::string& label) -> int;
+
+  void release_slot(const int& index);
+
+  /*
+    Each slot has a single writer: the thread where the plugin calls notify(). No locks or allocations happen here so
+    it is safe to call it from the realtime thread.
+  */
+
+  void publish_levels(const int& index,
+                      const float& input_left,
+                      const float& input_right,
+                      const float& output_left,
+                      const float& output_right,
+                      std::span<const float> values);
+
+  void publish_spectrum(const PipelineType& pipeline, const uint& rate, const std::vector<double>& magnitudes);
+
+ private:
+  GSettings* settings = nullptr;
+
+  std::vector<gulong> gconnections;
+
+  std::atomic<bool> enabled = false;
+
+  int fd = -1;
+
+  meters_export::Layout* layout = nullptr;
+
+  struct SlotInfo {
+    bool in_use = false;
+
+    PipelineType pipeline = PipelineType::output;
+
+    std::string label;
+  };
+
+  std::array<SlotInfo, meters_export::max_slots> slots_info;
+
+  void enable();
+
+  void disable();
+
+  void write_slot_header(const int& index);
+
+  static auto info_file_path() -> std::string;
+};
@@ -41,7 +41,13 @@ G_END_DECLS
 
 auto create() -> MultibandCompressorBandBox*;
 
-void setup(MultibandCompressorBandBox* self, GSettings* settings, int index);
+void setup(MultibandCompressorBandBox* self, GSettings* settings);
+
+// A single box is shown at a time. Selecting another band binds it again to that band
+
+void bind(MultibandCompressorBandBox* self, int index);
+
+void unbind(MultibandCompressorBandBox* self);
 
 void set_end_label(MultibandCompressorBandBox* self, const float& value);
 
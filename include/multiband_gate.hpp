@@ -63,22 +63,36 @@ class MultibandGate : public PluginBase {
 
   void update_probe_links() override;
 
-  sigc::signal<void(const std::array<float, n_bands>)> reduction, envelope, curve, frequency_range;
+  // Meters of all the bands read in the same notification window
 
-  float latency_port_value = 0.0F;
+  struct BandMeters {
+    std::array<float, n_bands> frequency_range_end{};
+    std::array<float, n_bands> envelope{};
+    std::array<float, n_bands> curve{};
+    std::array<float, n_bands> reduction{};
+  };
 
-  std::array<float, n_bands> frequency_range_end_port_array = {0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F};
-  std::array<float, n_bands> envelope_port_array = {0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F};
-  std::array<float, n_bands> curve_port_array = {0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F};
-  std::array<float, n_bands> reduction_port_array = {0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F};
+  sigc::signal<void(const BandMeters)> band_meters;
 
  private:
   uint latency_n_frames = 0U;
 
+  static constexpr uint n_band_meter_ports = 7U;  // fre, elm_l, elm_r, clm_l, clm_r, rlm_l and rlm_r
+
+  uint latency_port_index = lv2::Lv2Wrapper::invalid_port_index;
+
+  std::array<uint, n_bands * n_band_meter_ports> band_meter_ports{};
+
+  std::array<float, n_bands * n_band_meter_ports> band_meter_port_values{};
+
+  BandMeters band_meters_values;
+
   std::vector<pw_proxy*> list_proxies;
 
   void update_sidechain_links(const std::string& key);
 
+  void resolve_meter_ports();
+
   template <size_t n>
   constexpr void bind_band() {
     using namespace tags::multiband_gate;
@@ -37,7 +37,13 @@ G_END_DECLS
 
 auto create() -> MultibandGateBandBox*;
 
-void setup(MultibandGateBandBox* self, GSettings* settings, int index);
+void setup(MultibandGateBandBox* self, GSettings* settings);
+
+// A single box is shown at a time. Selecting another band binds it again to that band
+
+void bind(MultibandGateBandBox* self, int index);
+
+void unbind(MultibandGateBandBox* self);
 
 void set_end_label(MultibandGateBandBox* self, const float& value);
 
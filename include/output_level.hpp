@@ -21,6 +21,7 @@
 
 #include <span>
 #include <string>
+#include "ducker.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 
@@ -45,4 +46,8 @@ class OutputLevel : public PluginBase {
                std::span<float>& right_out) override;
 
   auto get_latency_seconds() -> float override;
+
+  // Only used in the output pipeline
+
+  Ducker ducker;
 };
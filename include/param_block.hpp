@@ -0,0 +1,85 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <type_traits>
+
+/*
+  Plugin parameters written by the main thread and read by the realtime thread. It is a triple buffer. The writer edits
+  its own copy and publishes it as a whole. The reader takes the most recent published copy when a quantum starts.
+  This way a value never changes in the middle of a quantum and the values edited together are applied together.
+  Neither side blocks or allocates.
+
+  There can be only one writer thread and one reader thread.
+*/
+
+template <typename T>
+class ParamBlock {
+ public:
+  static_assert(std::is_trivially_copyable_v<T>);
+
+  ParamBlock() = default;
+  explicit ParamBlock(const T& initial) : staged(initial) { slots.fill(initial); }
+  ParamBlock(const ParamBlock&) = delete;
+  auto operator=(const ParamBlock&) -> ParamBlock& = delete;
+  ParamBlock(const ParamBlock&&) = delete;
+  auto operator=(const ParamBlock&&) -> ParamBlock& = delete;
+  ~ParamBlock() = default;
+
+  // Writer side. The edit is applied on top of the last written values and published right away
+
+  template <typename F>
+  void update(F&& edit) {
+    edit(staged);
+
+    slots[back] = staged;
+
+    back = middle.exchange(back | dirty, std::memory_order_acq_rel) & index_mask;
+  }
+
+  // Writer side. The last written values
+
+  [[nodiscard]] auto written() const -> const T& { return staged; }
+
+  // Reader side. It has to be called once at the beginning of each quantum
+
+  auto acquire() -> const T& {
+    if ((middle.load(std::memory_order_relaxed) & dirty) != 0U) {
+      front = middle.exchange(front, std::memory_order_acq_rel) & index_mask;
+    }
+
+    return slots[front];
+  }
+
+ private:
+  static constexpr unsigned index_mask = 3U;
+
+  static constexpr unsigned dirty = 4U;
+
+  std::array<T, 3U> slots{};
+
+  T staged{};
+
+  unsigned back = 0U, front = 1U;
+
+  std::atomic<unsigned> middle = 2U;  // index of the slot in between plus the dirty flag
+};
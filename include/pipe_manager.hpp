@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <gio/gio.h>
 #include <pipewire/context.h>
 #include <pipewire/core.h>
 #include <pipewire/extensions/metadata.h>
@@ -32,7 +33,10 @@
 #include <cstddef>
 #include <cstdint>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 #include "pipe_objects.hpp"
 
@@ -54,10 +58,21 @@ class PipeManager {
 
   inline static bool exclude_monitor_stream = true;
 
+  /*
+    When true the last filter of the input pipeline is our virtual source instead of a null-audio-sink adapter. That
+    removes one node from the recording path. It has to be set before PipeManager is created.
+  */
+
+  inline static bool ee_source_is_filter = false;
+
   spa_hook metadata_listener{};
 
   std::map<uint64_t, NodeInfo> node_map;
 
+  // Node ids of our filters by node name. The filters have no media class and are not in node_map
+
+  std::map<std::string, uint> filter_nodes;
+
   std::vector<LinkInfo> list_links;
 
   std::vector<PortInfo> list_ports;
@@ -98,12 +113,62 @@ class PipeManager {
 
   void disconnect_stream(const uint& id) const;
 
-  void set_node_volume(pw_proxy* proxy, const uint& n_vol_ch, const float& value) const;
+  /*
+    Null sinks used as the entry of the per application chains. The call does not wait for the node. It is announced
+    by app_chain_sink_added once it is in node_map.
+  */
+
+  auto create_app_chain_sink(const std::string& name, const std::string& description) -> bool;
+
+  void destroy_app_chain_sink(const std::string& name);
+
+  /*
+    The routed output streams play to the sink of their application chain instead of ours. The routes are read by the
+    PipeWire thread, so they are changed with the loop lock held. They do not move the stream by themselves.
+  */
+
+  void set_app_chain_route(const uint& stream_id, const NodeInfo& sink);
+
+  void remove_app_chain_route(const uint& stream_id);
+
+  /*
+    Volume and mute changes are not sent right away. They are queued by node serial and sent together from the main
+    loop with a single roundtrip. A new value for a node replaces the one that is still pending. These can be called
+    from any thread but the PipeWire one.
+  */
+
+  void set_node_volume(const uint64_t& serial, const uint& n_vol_ch, const float& value);
+
+  void set_node_mute(const uint64_t& serial, const bool& state);
+
+  /*
+    Applied to all the streams of media_class. When media_role is not empty only the streams with this role are
+    changed. The volume is the value of a volume slider, from 0 to 1, and it is mapped like the one of the application
+    rows.
+  */
+
+  void set_streams_volume(const std::string& media_class, const std::string& media_role, const float& value);
+
+  void set_streams_mute(const std::string& media_class, const std::string& media_role, const bool& state);
+
+  // The stream volume for a slider value. It is cubic when the "use-cubic-volumes" key is enabled
+
+  [[nodiscard]] auto slider_to_volume(const float& value) const -> float;
 
-  void set_node_mute(pw_proxy* proxy, const bool& state) const;
+  // Sends the pending volume and mute changes. Usually there is no need to call it directly
+
+  void flush_node_controls();
 
   auto count_node_ports(const uint& node_id) -> uint;
 
+  // Waits until the filter acting as our virtual source is in the node map
+
+  void set_ee_source_filter(const uint& node_id);
+
+  // Estimate of the bytes used by the lists of PipeWire objects we keep. The strings inside them are not counted.
+
+  [[nodiscard]] auto get_memory_usage() const -> size_t;
+
   /*
     Links the output ports of the node output_node_id to the input ports of the node input_node_id
   */
@@ -113,6 +178,23 @@ class PipeManager {
                   const bool& probe_link = false,
                   const bool& link_passive = true) -> std::vector<pw_proxy*>;
 
+  /*
+    Links a sidechain source to the probe ports of node_id. The source is the name of a capture device, of an
+    application output stream or of one of our filters. This way the sidechain can be fed by the other pipeline or by
+    an earlier point of the same one. If there is no node with this name our virtual source is used. Sources that
+    would close a cycle in the graph are refused.
+  */
+
+  auto link_sidechain(const std::string& source_name, const uint& node_id) -> std::vector<pw_proxy*>;
+
+  // True when node_id is reached by following the links that leave origin_id
+
+  auto is_downstream(const uint& origin_id, const uint& node_id) -> bool;
+
+  // True when node_id is one of our filters placed before the pipeline end named end_name
+
+  auto feeds_pipeline_end(const std::string& end_name, const uint& node_id) -> bool;
+
   void destroy_object(const int& id) const;
 
   /*
@@ -152,6 +234,7 @@ class PipeManager {
   sigc::signal<void(NodeInfo)> sink_added;
   sigc::signal<void(NodeInfo)> sink_changed;
   sigc::signal<void(NodeInfo)> sink_removed;
+  sigc::signal<void(NodeInfo)> app_chain_sink_added;
   sigc::signal<void(std::string)> new_default_sink_name;
   sigc::signal<void(std::string)> new_default_source_name;
   sigc::signal<void(DeviceInfo)> device_input_route_changed;
@@ -159,11 +242,45 @@ class PipeManager {
 
   sigc::signal<void(const LinkInfo)> link_changed;
 
+  // The removal signals give the object id
+
+  sigc::signal<void(const ModuleInfo)> module_added;
+  sigc::signal<void(const ModuleInfo)> module_changed;
+  sigc::signal<void(const uint)> module_removed;
+  sigc::signal<void(const ClientInfo)> client_added;
+  sigc::signal<void(const ClientInfo)> client_changed;
+  sigc::signal<void(const uint)> client_removed;
+
  private:
+  GSettings* settings = nullptr;
+
   pw_context* context = nullptr;
   pw_proxy *proxy_stream_output_sink = nullptr, *proxy_stream_input_source = nullptr;
 
+  std::map<std::string, pw_proxy*> app_chain_sink_proxies;
+
+  std::map<uint, NodeInfo> app_chain_routes;  // the key is the stream id
+
   spa_hook core_listener{}, registry_listener{};
 
+  struct PendingNodeControl {
+    std::optional<float> volume;
+
+    uint n_vol_ch = 0U;
+
+    std::optional<bool> mute;
+  };
+
+  std::map<uint64_t, PendingNodeControl> pending_node_controls;
+
+  std::mutex pending_node_controls_mutex;
+
+  bool node_controls_flush_scheduled = false;
+
+  void schedule_node_controls_flush();
+
+  auto get_streams(const std::string& media_class, const std::string& media_role)
+      -> std::vector<std::pair<uint64_t, uint>>;  // serial and number of volume channels
+
   void set_metadata_target_node(const uint& origin_id, const uint& target_id, const uint64_t& target_serial) const;
 };
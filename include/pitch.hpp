@@ -20,6 +20,7 @@
 #pragma once
 
 #include <STTypes.h>
+#include <cstddef>
 #include <deque>
 #include <span>
 #include <string>
@@ -56,6 +57,8 @@ class Pitch : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  auto count_memory_usage() -> size_t override;
+
  private:
   bool soundtouch_ready = false;
   bool notify_latency = false;
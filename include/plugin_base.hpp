@@ -22,16 +22,25 @@
 #include <gio/gio.h>
 #include <glib.h>
 #include <pipewire/filter.h>
+#include <pipewire/proxy.h>
 #include <sigc++/signal.h>
+#include <spa/utils/defs.h>
 #include <spa/utils/hook.h>
 #include <sys/types.h>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <string>
 #include <vector>
+#include "analyzer_taps.hpp"
 #include "lv2_wrapper.hpp"
+#include "meters_export.hpp"
+#include "param_block.hpp"
 #include "pipe_manager.hpp"
 #include "pipeline_type.hpp"
 #include "util.hpp"
@@ -52,6 +61,13 @@ class PluginBase {
   auto operator=(const PluginBase&&) -> PluginBase& = delete;
   virtual ~PluginBase();
 
+  /*
+    Owned by the application. When it is not null the level meters of every plugin are also published in the shared
+    memory region it manages.
+  */
+
+  inline static MetersExport* meters_export = nullptr;
+
   struct data;
 
   struct port {
@@ -75,6 +91,8 @@ class PluginBase {
 
   std::string name, package;
 
+  std::string filter_name;  // node name in the PipeWire graph
+
   PipelineType pipeline_type{};
 
   pw_filter* filter = nullptr;
@@ -91,6 +109,8 @@ class PluginBase {
 
   bool package_installed = true;
 
+  // Realtime thread copy of common_params. The main thread changes it through set_bypass
+
   bool bypass = false;
 
   bool connected_to_pw = false;
@@ -107,14 +127,78 @@ class PluginBase {
 
   std::vector<float> dummy_left, dummy_right;
 
+  // Read in the realtime thread. See set_analyzer_tap
+
+  std::atomic<AnalyzerTap*> analyzer_tap = nullptr;
+
+  std::atomic<TapPoint> analyzer_tap_point = TapPoint::output;
+
+  // When true the output buffers are zeroed after process(). The meters still see the real output
+
+  std::atomic<bool> output_muted = false;
+
+  // Fraction of the audio duration spent inside process(). Updated once per notification window
+
+  std::atomic<float> dsp_load = 0.0F;
+
+  double process_seconds = 0.0, audio_seconds = 0.0;  // accumulated by the realtime thread for dsp_load
+
   [[nodiscard]] auto get_node_id() const -> uint;
 
   void set_active(const bool& state) const;
 
+  void set_bypass(const bool& state);
+
+  // Main thread. The last value given to set_bypass
+
+  [[nodiscard]] auto get_bypass() const -> bool;
+
+  // Realtime thread. Picks the bypass and gains published by the main thread. It is called once per quantum
+
+  void acquire_common_params();
+
+  /*
+    The equal power law uses sin(x * pi / 2) as gain, with x changing linearly. A fade out summed with a simultaneous
+    fade in keeps the power constant when the two signals are unrelated. Signals that are the same, like two chains
+    with the same preset, need the linear law or they get 3 dB louder in the middle of the fade.
+  */
+
+  enum class FadeLaw { equal_power, linear };
+
+  // Moves the gain applied to the filter output to target, 0 or 1, in the given time
+
+  void fade_to(const float& target, const float& seconds, const FadeLaw& law = FadeLaw::equal_power);
+
+  // Realtime thread. Applies the fade to the output buffers
+
+  void apply_fade(std::span<float>& left, std::span<float>& right);
+
   void set_post_messages(const bool& state);
 
+  void set_export_meters(const bool& state);
+
+  /*
+    Feeds the tap with the plugin input or output. A null tap detaches it. The realtime thread may still be writing to
+    the previous tap when this returns, so the caller has to keep it alive.
+  */
+
+  void set_analyzer_tap(AnalyzerTap* tap, const TapPoint& point);
+
   auto connect_to_pw() -> bool;
 
+  // Makes this filter the Easy Effects virtual source. It has to be called before the filter is connected
+
+  void expose_as_virtual_source();
+
+  /*
+    connect_to_pw() split in two halves. Starting the connection of many filters before waiting for any of them lets
+    the server create their nodes concurrently instead of paying one round trip per filter.
+  */
+
+  auto start_pw_connection() -> bool;
+
+  auto finish_pw_connection() -> bool;
+
   void disconnect_from_pw();
 
   void reset_settings();
@@ -143,10 +227,52 @@ class PluginBase {
 
   virtual auto get_latency_seconds() -> float;
 
+  /*
+    Shared lookahead. In a run of consecutive plugins with lookahead only the first one delays the signal, by the
+    largest lookahead of the run. The others set their own lookahead to zero and their detector reads ahead through
+    the probe, linked to the node before the first plugin of the run. See EffectsBase::update_shared_lookahead
+  */
+
+  // Milliseconds. Zero when the plugin has no lookahead
+
+  [[nodiscard]] virtual auto get_lookahead_ms() -> double;
+
+  // True when moving the detector to the probe does not change what it measures
+
+  [[nodiscard]] virtual auto can_read_ahead() -> bool;
+
+  // source_node_id is SPA_ID_INVALID for the plugin that delays the signal. A zero lookahead restores the settings
+
+  void set_shared_lookahead(const double& lookahead_ms, const uint& source_node_id);
+
+  /*
+    Estimate of the bytes allocated by the plugin for its own buffers. Libraries are included only when their usage
+    can be derived from what we asked them to allocate. It never waits for the realtime thread. While it holds the
+    buffers the previous estimate is returned.
+  */
+
+  auto get_memory_usage() -> size_t;
+
+  // The part of get_memory_usage implemented by the subclasses. It is called with data_mutex held
+
+  virtual auto count_memory_usage() -> size_t;
+
+  // Frees data that can be recreated later. Called from the main thread once per crossing of the memory budget
+
+  virtual void release_caches();
+
   sigc::signal<void(const float, const float)> input_level;
   sigc::signal<void(const float, const float)> output_level;
   sigc::signal<void()> latency;
 
+  // Emitted when the user changes the "bypass" key
+
+  sigc::signal<void(const bool)> bypass_changed;
+
+  // Emitted when the lookahead or the settings deciding if the plugin can read ahead change
+
+  sigc::signal<void()> lookahead_changed;
+
  protected:
   std::mutex data_mutex;
 
@@ -160,11 +286,50 @@ class PluginBase {
 
   bool post_messages = false;
 
+  bool export_meters = false;
+
+  int meters_slot = -1;
+
+  /*
+    Plugin specific values exported together with the level meters in the next notify() call. Subclasses fill them
+    in the realtime thread right before calling notify().
+  */
+
+  std::array<float, meters_export::max_values> meter_values{};
+
+  uint n_meter_values = 0U;
+
   uint n_ports = 4U;
 
+  struct CommonParams {
+    bool bypass = false;
+
+    float input_gain = 1.0F;
+    float output_gain = 1.0F;
+  };
+
+  // Copied to bypass, input_gain and output_gain at the beginning of each quantum
+
+  ParamBlock<CommonParams> common_params;
+
   float input_gain = 1.0F;
   float output_gain = 1.0F;
 
+  struct Fade {
+    float target = 1.0F;
+    float seconds = 0.0F;
+
+    FadeLaw law = FadeLaw::equal_power;
+  };
+
+  ParamBlock<Fade> fade_params;
+
+  float fade_position = 1.0F;  // realtime thread
+
+  double shared_lookahead_ms = 0.0;
+
+  uint shared_lookahead_source_id = SPA_ID_INVALID;
+
   std::unique_ptr<lv2::Lv2Wrapper> lv2_wrapper;
 
   std::vector<gulong> gconnections;
@@ -184,9 +349,58 @@ class PluginBase {
 
   void update_filter_params();
 
+  // False while the native ui is open. Otherwise closing it would write the overridden ports to our settings
+
+  auto uses_shared_lookahead() -> bool;
+
+  auto reads_ahead() -> bool;
+
+  // Links the probe to the node the detector reads ahead from. On failure the plugin goes back to its own lookahead
+
+  auto link_read_ahead_source() -> std::vector<pw_proxy*>;
+
+  /*
+    The lv2 ports of a plugin with a lookahead. The detector reads the probe when the sidechain enum port is set to
+    external_sidechain. It can read ahead only while the sidechain key is read_ahead_value. Without a sidechain key the
+    plugin never reads ahead. The sidechain preamp also takes the input gain while reading ahead because the probe
+    does not go through it. The gains of the plugins before this one in the run are still not seen by the detector.
+  */
+
+  struct LookaheadPorts {
+    std::string lookahead_key, lookahead_port;
+
+    std::string sidechain_key, sidechain_port, read_ahead_value;
+
+    int external_sidechain = 0;
+
+    std::string preamp_key, preamp_port;
+  };
+
+  // Enables the shared lookahead. It has to be called after the bindings of these ports because it overrides them
+
+  void setup_shared_lookahead(const LookaheadPorts& ports);
+
+  // Updates the probe links and writes the ports overridden by the shared lookahead
+
+  void apply_shared_lookahead();
+
+  // The values come from the settings when the shared lookahead is not in use. The links are not touched
+
+  void write_lookahead_ports();
+
+  void write_sidechain_preamp();
+
  private:
   uint node_id = 0U;
 
+  bool connecting_to_pw = false;
+
+  bool post_messages_ui = false;
+
+  size_t memory_usage = 0U;
+
+  std::optional<LookaheadPorts> lookahead_ports;
+
   float input_peak_left = util::minimum_linear_level, input_peak_right = util::minimum_linear_level;
   float output_peak_left = util::minimum_linear_level, output_peak_right = util::minimum_linear_level;
 };
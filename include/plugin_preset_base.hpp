@@ -70,6 +70,13 @@ class PluginPresetBase {
     g_settings_apply(settings);
   }
 
+  /*
+    Points the wrapper to the instance of the same plugin inside another pipeline. base_path replaces the path of the
+    pipeline selected by the preset type. Used by the per application chains.
+  */
+
+  virtual void relocate(const std::string& base_path);
+
  protected:
   int index = 0;
 
@@ -83,6 +90,10 @@ class PluginPresetBase {
 
   virtual void load(const nlohmann::json& json) = 0;
 
+  // Returns a new object of the same schema at the relocated path
+
+  [[nodiscard]] auto relocated_settings(GSettings* source, const std::string& base_path) const -> GSettings*;
+
   template <typename T>
   auto get_default(GSettings* settings, const std::string& key) -> T {
     GVariant* variant = g_settings_get_default_value(settings, key.c_str());
@@ -0,0 +1,55 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <string>
+#include "effects_base.hpp"
+#include "pipe_manager.hpp"
+#include "pipeline_type.hpp"
+
+/*
+  Staging copy of a pipeline used by EffectsBase::crossfade_to_preset. The new preset is loaded into it before it is
+  created and it plays in parallel with the pipeline it mirrors. Its spectrum filter is the last node and its fader
+  starts closed. The output is mixed with the main pipeline by the node that comes after the pipeline.
+*/
+
+class PresetStage : public EffectsBase {
+ public:
+  PresetStage(const std::string& tag, PipeManager* pipe_manager, PipelineType pipe_type);
+  PresetStage(const PresetStage&) = delete;
+  auto operator=(const PresetStage&) -> PresetStage& = delete;
+  PresetStage(const PresetStage&&) = delete;
+  auto operator=(const PresetStage&&) -> PresetStage& = delete;
+  ~PresetStage() override;
+
+  // Time given to new filters to start and to load their data before they are heard
+
+  static constexpr uint warmup_ms = 250U;
+
+  static auto make_schema_path(const PipelineType& pipe_type) -> std::string;
+
+  // source_id feeds the chain and mix_node_id receives its output together with the output of the main pipeline
+
+  auto connect_filters(const uint& source_id, const uint& mix_node_id) -> bool;
+
+ private:
+  void disconnect_filters();
+};
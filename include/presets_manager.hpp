@@ -21,12 +21,17 @@
 
 #include <gio/gio.h>
 #include <sigc++/signal.h>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <nlohmann/json_fwd.hpp>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 #include "plugin_preset_base.hpp"
 #include "preset_type.hpp"
@@ -83,14 +88,43 @@ class PresetsManager {
                                   const std::string& full_path_stem,
                                   const std::string& package_name) -> bool;
 
+  /*
+    Loads a local output preset into the application chain whose settings live at base_path. The blocklist of the
+    preset is ignored.
+  */
+
+  auto load_app_chain_preset(const std::string& name, const std::string& base_path) -> bool;
+
+  /*
+    Writes the preset to the pipeline. When base_path is not empty it goes to the relocated pipeline at this path and
+    the blocklist is ignored.
+  */
+
+  auto apply_preset_file(const PresetType& preset_type,
+                         const std::filesystem::path& input_file,
+                         const std::string& base_path = "") -> bool;
+
+  /*
+    Called when a crossfade could not apply the preset it was started with. load_preset_file returned before that
+    happened, so the last loaded preset keys are reset here.
+  */
+
+  void on_deferred_preset_failed(const PresetType& preset_type, const std::filesystem::path& preset_file);
+
+  // When pipeline_settings is null the plugins list is written to the pipeline selected by preset_type
+
   auto read_effects_pipeline_from_preset(const PresetType& preset_type,
                                          const std::filesystem::path& input_file,
                                          nlohmann::json& json,
-                                         std::vector<std::string>& plugins) -> bool;
+                                         std::vector<std::string>& plugins,
+                                         GSettings* pipeline_settings = nullptr) -> bool;
+
+  // When base_path is not empty the plugins parameters are written to the pipeline at this path
 
   auto read_plugins_preset(const PresetType& preset_type,
                            const std::vector<std::string>& plugins,
-                           const nlohmann::json& json) -> bool;
+                           const nlohmann::json& json,
+                           const std::string& base_path = "") -> bool;
 
   void import_from_filesystem(const PresetType& preset_type, const std::string& file_path);
 
@@ -126,11 +160,28 @@ class PresetsManager {
   sigc::signal<void(const std::vector<nlohmann::json>& profiles)> autoload_input_profiles_changed;
   sigc::signal<void(const std::vector<nlohmann::json>& profiles)> autoload_output_profiles_changed;
 
+  /*
+    Saving and importing are done by a worker thread. These signals are emitted in the main thread. The progress is a
+    fraction between 0 and 1.
+  */
+
+  sigc::signal<void(const PresetType preset_type, const std::string description, const double progress)>
+      task_progress;
+
+  sigc::signal<void(const PresetType preset_type, const std::string description, const bool success)> task_finished;
+
+  /*
+    Emitted instead of writing a loaded preset when "preset-crossfade-time" is not zero. The handler crossfades the
+    pipeline to the preset and writes it through apply_preset_file.
+  */
+
+  sigc::signal<void(const PresetType preset_type, const std::string preset_file)> crossfade_requested;
+
  private:
   std::string user_config_dir;
 
   std::filesystem::path user_input_dir, user_output_dir, user_irs_dir, user_rnnoise_dir, autoload_input_dir,
-      autoload_output_dir;
+      autoload_output_dir, staging_dir;
 
   std::vector<std::string> system_data_dir_input, system_data_dir_output, system_data_dir_irs, system_data_dir_rnnoise;
 
@@ -140,11 +191,34 @@ class PresetsManager {
 
   GFileMonitor *autoload_output_monitor = nullptr, *autoload_input_monitor = nullptr;
 
+  bool exiting = false;
+
+  std::deque<std::function<void()>> tasks;
+
+  std::mutex tasks_mutex;
+
+  std::condition_variable tasks_cv;
+
+  std::thread worker;
+
+  void run_tasks();
+
+  void queue_task(std::function<void()> task);
+
+  void notify_task_progress(const PresetType& preset_type, const std::string& description, const double& progress);
+
+  void notify_task_finished(const PresetType& preset_type, const std::string& description, const bool& success);
+
+  auto write_file_atomically(const std::filesystem::path& output_file, const std::string& contents) -> bool;
+
+  auto copy_file_atomically(const std::filesystem::path& input_file, const std::filesystem::path& output_file) -> bool;
+
   static void create_user_directory(const std::filesystem::path& path);
 
   auto import_addons_from_community_package(const PresetType& preset_type,
                                             const std::filesystem::path& path,
-                                            const std::string& package) -> bool;
+                                            const std::string& package,
+                                            const std::string& description) -> bool;
 
   void set_last_preset_keys(const PresetType& preset_type,
                             const std::string& preset_name = "",
@@ -152,6 +226,10 @@ class PresetsManager {
 
   auto load_preset_file(const PresetType& preset_type, const std::filesystem::path& input_file) -> bool;
 
+  // Parses the preset without applying it. Used before a crossfade, which applies the preset later
+
+  auto validate_preset_file(const PresetType& preset_type, const std::filesystem::path& input_file) -> bool;
+
   void save_blocklist(const PresetType& preset_type, nlohmann::json& json);
 
   auto load_blocklist(const PresetType& preset_type, const nlohmann::json& json) -> bool;
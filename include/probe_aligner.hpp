@@ -0,0 +1,106 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/*
+  Keeps the reference signal of a probe input aligned with the main input. Inside our filter both are delivered in
+  buffers of the same size, so a clock mismatch between the devices is not visible directly. What we see is its effect
+  over time: PipeWire's adaptive resampling of the follower device moves its buffer level and the delay between the
+  reference and its echo in the main input slowly changes. After a long call it can leave the echo canceller window.
+
+  The delay is estimated by correlating the 10 ms energy envelopes of both signals over the last seconds. A locked loop
+  moves a fractional delay line toward the estimate by at most max_slew samples per sample. This is the same as
+  resampling the reference by a ratio that never differs from one by more than max_slew. The echo is kept margin
+  samples after the reference so that it stays inside the canceller window.
+*/
+
+class ProbeAligner {
+ public:
+  ProbeAligner() = default;
+  ProbeAligner(const ProbeAligner&) = delete;
+  auto operator=(const ProbeAligner&) -> ProbeAligner& = delete;
+  ProbeAligner(const ProbeAligner&&) = delete;
+  auto operator=(const ProbeAligner&&) -> ProbeAligner& = delete;
+  ~ProbeAligner() = default;
+
+  static constexpr uint frame_ms = 10U;
+
+  static constexpr uint history_frames = 400U;
+
+  static constexpr uint max_lag_frames = 50U;
+
+  static constexpr uint frames_between_estimates = 50U;
+
+  static constexpr float max_slew = 2e-4F;
+
+  // Allocates the buffers. It has to be called when the rate changes
+
+  void setup(const uint& rate);
+
+  void set_margin_ms(const uint& value);
+
+  // The probe buffers are delayed in place
+
+  void process(std::span<const float> main, std::span<float> probe_left, std::span<float> probe_right);
+
+  void reset();
+
+  [[nodiscard]] auto get_memory_usage() const -> size_t;
+
+ private:
+  uint rate = 0U;
+
+  uint frame_size = 0U;
+
+  uint margin_ms = 25U;
+
+  float delay = 0.0F;  // in samples
+
+  float target_delay = 0.0F;
+
+  // envelope of the current frame
+
+  uint frame_position = 0U;
+
+  float main_energy = 0.0F, probe_energy = 0.0F;
+
+  // envelope history. Ring buffers of history_frames
+
+  std::vector<float> main_envelope, probe_envelope;
+
+  size_t envelope_position = 0U;
+
+  uint n_envelope_frames = 0U;
+
+  uint frames_since_estimate = 0U;
+
+  // delay line of the probe
+
+  std::vector<float> delay_line_L, delay_line_R;
+
+  size_t write_position = 0U;
+
+  void estimate_delay();
+};
@@ -28,6 +28,7 @@
 #include <span>
 #include <string>
 #include <vector>
+#include "param_block.hpp"
 #include "pipe_manager.hpp"
 #ifdef ENABLE_RNNOISE
 #include <rnnoise.h>
@@ -59,6 +60,8 @@ class RNNoise : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  auto count_memory_usage() -> size_t override;
+
   void init_release();
 
   auto search_model_path(const std::string& name) -> std::string;
@@ -81,14 +84,29 @@ class RNNoise : public PluginBase {
   bool notify_latency = false;
   bool rnnoise_ready = false;
   bool resampler_ready = false;
-  bool enable_vad = false;
 
   uint blocksize = 480U;
   uint rnnoise_rate = 48000U;
   uint latency_n_frames = 0U;
 
+  struct VadParams {
+    bool enable_vad = false;
+
+    float vad_thres = 0.95F;
+    float wet_ratio = 1.0F;
+
+    uint release = 2U;  // in rnnoise blocks
+  };
+
+  ParamBlock<VadParams> vad_params;
+
+  // Realtime thread copies of vad_params. They are refreshed at the beginning of each quantum
+
+  bool enable_vad = false;
+
   float vad_thres = 0.95F;
   float wet_ratio = 1.0F;
+
   uint release = 2U;
 
   const float inv_short_max = 1.0F / (SHRT_MAX + 1.0F);
@@ -0,0 +1,73 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/*
+  Realtime safety checks. They are only compiled when the project is configured with -Denable-rt-checks=true.
+
+  The code running inside a Scope is expected to be realtime safe. While a thread is inside one, memory allocations,
+  blocking syscalls, contended mutexes and the calls marked with rt_checks::check are reported on stderr together with
+  the name given to the scope and a stack trace. Each call site is reported only once.
+
+  Without the build option everything here is a no-op.
+*/
+
+namespace rt_checks {
+
+#ifdef ENABLE_RT_CHECKS
+
+void enter_scope(const char* name);
+
+void leave_scope(const char* previous_name);
+
+auto current_scope() -> const char*;
+
+// Reports `what` if the calling thread is inside a realtime scope
+
+void check(const char* what);
+
+#else
+
+inline void enter_scope([[maybe_unused]] const char* name) {}
+
+inline void leave_scope([[maybe_unused]] const char* previous_name) {}
+
+inline auto current_scope() -> const char* {
+  return nullptr;
+}
+
+inline void check([[maybe_unused]] const char* what) {}
+
+#endif
+
+class Scope {
+ public:
+  explicit Scope(const char* name) : previous_name(current_scope()) { enter_scope(name); }
+  Scope(const Scope&) = delete;
+  auto operator=(const Scope&) -> Scope& = delete;
+  Scope(const Scope&&) = delete;
+  auto operator=(const Scope&&) -> Scope& = delete;
+  ~Scope() { leave_scope(previous_name); }
+
+ private:
+  const char* previous_name = nullptr;
+};
+
+}  // namespace rt_checks
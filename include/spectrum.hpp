@@ -22,6 +22,8 @@
 #include <fftw3.h>
 #include <sigc++/signal.h>
 #include <sys/types.h>
+#include <atomic>
+#include <cstddef>
 #include <deque>
 #include <span>
 #include <string>
@@ -51,11 +53,35 @@ class Spectrum : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
-  sigc::signal<void(uint, uint, std::vector<double>)> power;  // rate, nbands, magnitudes
+  auto count_memory_usage() -> size_t override;
+
+  // While an analyzer tap is feeding the chart the spectrum at the end of the pipeline is not computed
+
+  void set_external_tap(const bool& state);
+
+  // Shows the spectrum computed by an analyzer tap. In the logarithmic mode the bins are gathered in the chart bands
+
+  void show_tap_power(const uint& tap_rate, const std::vector<double>& magnitudes);
+
+  // The exported spectrum is computed even while the chart is hidden
+
+  void set_export_spectrum(const bool& state);
+
+  [[nodiscard]] auto is_exported() const -> bool;
+
+  sigc::signal<void(uint, uint, const std::vector<double>&)> power;  // rate, nbands, magnitudes
+
+  // Emitted instead of power in the logarithmic mode
+
+  sigc::signal<void(const std::vector<double>&, const std::vector<double>&)> log_power;  // frequencies, magnitudes
 
  private:
   bool fftw_ready = false;
 
+  bool external_tap = false;
+
+  std::atomic<bool> export_spectrum = false;
+
   fftwf_plan plan = nullptr;
 
   fftwf_complex* complex_output = nullptr;
@@ -66,4 +92,35 @@ class Spectrum : public PluginBase {
   uint n_bands = 8192U;
 
   std::deque<float> deque_in_mono;
+
+  void apply_window();
+
+  /*
+    Logarithmic mode. Only the n-points bands shown in the chart are computed. Each band is a Hann windowed DFT
+    evaluated at its center frequency over the last samples of real_input. The window length gives a constant Q
+    matching the spacing between the bands, so the low frequencies get long windows and the high ones short windows.
+    The kernels are only touched in the main thread.
+  */
+
+  struct LogBand {
+    double frequency = 0.0;
+
+    float normalization = 0.0F;
+
+    std::vector<float> kernel_cos, kernel_sin;
+  };
+
+  bool log_mode = false;
+
+  bool log_bands_dirty = true;
+
+  uint log_bands_rate = 0U;
+
+  std::vector<LogBand> log_bands;
+
+  std::vector<double> log_frequencies, log_output;
+
+  void init_log_bands();
+
+  void compute_log_bands();
 };
@@ -23,6 +23,7 @@
 #include <speex/speexdsp_config_types.h>
 #include <sys/types.h>
 #include <climits>
+#include <cstddef>
 #include <span>
 #include <string>
 #include <vector>
@@ -51,6 +52,8 @@ class Speex : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  auto count_memory_usage() -> size_t override;
+
  private:
   bool speex_ready = false;
 
@@ -21,6 +21,7 @@
 
 #include <span>
 #include <string>
+#include "param_block.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 
@@ -49,5 +50,9 @@ class StereoTools : public PluginBase {
   double correlation_port_value = 0.0;
 
  private:
-  float dry = 0.0F, wet = 1.0F;
+  struct Mix {
+    float dry = 0.0F, wet = 1.0F;
+  };
+
+  ParamBlock<Mix> mix;
 };
@@ -19,6 +19,10 @@
 
 #pragma once
 
+#include <glib.h>
+#include <sigc++/signal.h>
+#include <string>
+#include <vector>
 #include "effects_base.hpp"
 #include "pipe_manager.hpp"
 #include "pipe_objects.hpp"
@@ -36,13 +40,56 @@ class StreamInputEffects : public EffectsBase {
 
   void set_listen_to_mic(const bool& state);
 
+  /*
+    Denoiser comparison mode. The denoisers next to each other in the pipeline are fed by the same node and all their
+    outputs are linked to the next one. Only the denoiser named in "denoiser-comparison-output" is heard, the others
+    have their output muted. Switching between them does not touch the graph, so it is instantaneous and the engines
+    keep their state.
+  */
+
+  struct DenoiserStats {
+    std::string name;
+
+    float dsp_load = 0.0F;
+
+    float latency_ms = 0.0F;
+
+    bool monitored = false;
+  };
+
+  // Emitted once per second while the comparison mode is enabled. An empty list when it stops
+
+  sigc::signal<void(const std::vector<DenoiserStats>&)> denoiser_stats;
+
  private:
   bool bypass = false;
 
+  bool suspended = false;
+
+  guint denoiser_stats_timeout_id = 0U;
+
   void connect_filters(const bool& bypass = false);
 
   void disconnect_filters();
 
+  auto get_chain_source_id() -> uint override;
+
+  void relink_filters() override;
+
+  auto is_suspended() -> bool override;
+
+  void on_filters_bypass_changed() override;
+
+  void suspend_filters();
+
+  void resume_filters();
+
+  auto get_compared_denoisers() -> std::vector<std::string>;
+
+  void update_denoiser_comparison();
+
+  void broadcast_denoiser_stats();
+
   auto apps_want_to_play() -> bool;
 
   void on_app_added(NodeInfo node_info);
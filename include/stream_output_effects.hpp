@@ -19,6 +19,12 @@
 
 #pragma once
 
+#include <sigc++/signal.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include "app_chain.hpp"
 #include "effects_base.hpp"
 #include "pipe_manager.hpp"
 #include "pipe_objects.hpp"
@@ -34,16 +40,36 @@ class StreamOutputEffects : public EffectsBase {
 
   void set_bypass(const bool& state);
 
+  // Emitted before a chain is created. The preset named in "app-chains" has to be loaded into base_path
+
+  sigc::signal<void(const std::string preset_name, const std::string base_path)> load_app_chain_preset;
+
  private:
   bool bypass = false;
 
+  std::map<std::string, std::unique_ptr<AppChain>> app_chains;
+
   void connect_filters(const bool& bypass = false);
 
   void disconnect_filters();
 
+  auto get_chain_source_id() -> uint override;
+
+  void relink_filters() override;
+
   auto apps_want_to_play() -> bool;
 
   void on_app_added(NodeInfo node_info);
 
+  void on_app_removed(uint64_t serial);
+
+  // True when the stream is assigned to an application chain. It is connected to the chain sink once that exists
+
+  auto route_to_app_chain(const NodeInfo& node_info) -> bool;
+
+  void on_app_chain_sink_added(NodeInfo node_info);
+
   void on_link_changed(LinkInfo link_info);
+
+  void update_ducking();
 };
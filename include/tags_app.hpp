@@ -31,4 +31,8 @@ inline constexpr auto path_stream_inputs = "/com/github/wwmm/easyeffects/streami
 
 inline constexpr auto path_stream_outputs = "/com/github/wwmm/easyeffects/streamoutputs/";
 
+inline constexpr auto path_app_chains = "/com/github/wwmm/easyeffects/appchains/";
+
+inline constexpr auto path_preset_stage = "/com/github/wwmm/easyeffects/presetstage/";
+
 }  // namespace tags::app
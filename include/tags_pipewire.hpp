@@ -25,6 +25,16 @@ inline constexpr auto ee_source_name = "easyeffects_source";
 
 inline constexpr auto ee_sink_name = "easyeffects_sink";
 
+// Prefix of the sinks created for the per application chains
+
+inline constexpr auto ee_app_chain_sink_prefix = "easyeffects_app_";
+
+// Node names of the last filter of each effects pipeline
+
+inline constexpr auto ee_output_pipeline_end = "ee_soe_output_level";
+
+inline constexpr auto ee_input_pipeline_end = "ee_sie_output_level";
+
 }  // namespace tags::pipewire
 
 namespace tags::pipewire::media_class {
@@ -20,10 +20,13 @@
 #pragma once
 
 #include <sys/types.h>
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <map>
 #include <string>
 #include <string_view>
+#include "tags_schema.hpp"
 
 namespace tags::plugin_package {
 
@@ -115,10 +118,112 @@ inline constexpr auto list = std::to_array(
      filter,         gate,          level_meter,   limiter,        loudness,  maximizer,   multiband_compressor,
      multiband_gate, pitch,         reverb,        rnnoise,        speex,     stereo_tools});
 
-auto get_translated() -> std::map<std::string, std::string>;
+enum class Type : uint {
+  autogain,
+  bass_enhancer,
+  bass_loudness,
+  compressor,
+  convolver,
+  crossfeed,
+  crystalizer,
+  deepfilternet,
+  deesser,
+  delay,
+  echo_canceller,
+  equalizer,
+  exciter,
+  expander,
+  filter,
+  gate,
+  level_meter,
+  limiter,
+  loudness,
+  maximizer,
+  multiband_compressor,
+  multiband_gate,
+  pitch,
+  reverb,
+  rnnoise,
+  speex,
+  stereo_tools,
+};
+
+// none: always zero. fixed: depends only on the sampling rate. variable: the plugin emits its latency signal
+
+enum class LatencyClass { none, fixed, variable };
+
+struct Descriptor {
+  Type type;
+
+  const char* base_name;
+
+  const char* schema;
+
+  LatencyClass latency;
+};
+
+/*
+  One entry per effect, sorted by base name and in the same order as the Type enumeration. Code that has to do
+  something different for each effect should switch on the type of the descriptor returned by find(). This way the
+  compiler tells us about the places that were not updated when an effect is added.
+*/
+
+inline constexpr auto descriptors = std::to_array<Descriptor>({
+    {Type::autogain, autogain, tags::schema::autogain::id, LatencyClass::none},
+    {Type::bass_enhancer, bass_enhancer, tags::schema::bass_enhancer::id, LatencyClass::none},
+    {Type::bass_loudness, bass_loudness, tags::schema::bass_loudness::id, LatencyClass::none},
+    {Type::compressor, compressor, tags::schema::compressor::id, LatencyClass::variable},
+    {Type::convolver, convolver, tags::schema::convolver::id, LatencyClass::variable},
+    {Type::crossfeed, crossfeed, tags::schema::crossfeed::id, LatencyClass::none},
+    {Type::crystalizer, crystalizer, tags::schema::crystalizer::id, LatencyClass::variable},
+    {Type::deepfilternet, deepfilternet, tags::schema::deepfilternet::id, LatencyClass::fixed},
+    {Type::deesser, deesser, tags::schema::deesser::id, LatencyClass::none},
+    {Type::delay, delay, tags::schema::delay::id, LatencyClass::variable},
+    {Type::echo_canceller, echo_canceller, tags::schema::echo_canceller::id, LatencyClass::variable},
+    {Type::equalizer, equalizer, tags::schema::equalizer::id, LatencyClass::variable},
+    {Type::exciter, exciter, tags::schema::exciter::id, LatencyClass::none},
+    {Type::expander, expander, tags::schema::expander::id, LatencyClass::variable},
+    {Type::filter, filter, tags::schema::filter::id, LatencyClass::none},
+    {Type::gate, gate, tags::schema::gate::id, LatencyClass::variable},
+    {Type::level_meter, level_meter, tags::schema::level_meter::id, LatencyClass::none},
+    {Type::limiter, limiter, tags::schema::limiter::id, LatencyClass::variable},
+    {Type::loudness, loudness, tags::schema::loudness::id, LatencyClass::variable},
+    {Type::maximizer, maximizer, tags::schema::maximizer::id, LatencyClass::variable},
+    {Type::multiband_compressor, multiband_compressor, tags::schema::multiband_compressor::id, LatencyClass::variable},
+    {Type::multiband_gate, multiband_gate, tags::schema::multiband_gate::id, LatencyClass::variable},
+    {Type::pitch, pitch, tags::schema::pitch::id, LatencyClass::variable},
+    {Type::reverb, reverb, tags::schema::reverb::id, LatencyClass::none},
+    {Type::rnnoise, rnnoise, tags::schema::rnnoise::id, LatencyClass::variable},
+    {Type::speex, speex, tags::schema::speex::id, LatencyClass::variable},
+    {Type::stereo_tools, stereo_tools, tags::schema::stereo_tools::id, LatencyClass::none},
+});
+
+static_assert(descriptors.size() == list.size());
+
+static_assert(std::ranges::is_sorted(descriptors, {}, [](const Descriptor& d) {
+  return std::string_view(d.base_name);
+}));
+
+static_assert([] {
+  for (size_t n = 0U; n < descriptors.size(); n++) {
+    if (static_cast<size_t>(descriptors[n].type) != n) {
+      return false;
+    }
+  }
+
+  return true;
+}());
+
+// Accepts both the instance name (base_name#id) and the base name. Returns nullptr if the effect is unknown
+
+auto find(std::string_view name) -> const Descriptor*;
+
+auto get_descriptor(const Type& type) -> const Descriptor&;
+
+auto get_translated() -> const std::map<std::string, std::string>&;
 
 auto get_base_name(std::string_view name) -> std::string;
 
-auto get_id(const std::string& name) -> uint;
+auto get_id(std::string_view name) -> uint;
 
 }  // namespace tags::plugin_name
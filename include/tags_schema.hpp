@@ -25,6 +25,8 @@ inline constexpr auto id_input = "com.github.wwmm.easyeffects.streaminputs";
 
 inline constexpr auto id_output = "com.github.wwmm.easyeffects.streamoutputs";
 
+inline constexpr auto id_app_chain = "com.github.wwmm.easyeffects.appchain";
+
 }  // namespace tags::schema
 
 namespace tags::schema::autogain {
@@ -0,0 +1,105 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/*
+  True peak meter following ITU-R BS.1770-4 Annex 2. The signal is oversampled by the 48 taps polyphase FIR
+  interpolator given in the Annex and the largest absolute value of all phases is kept. The Annex describes 4x
+  oversampling for 48 kHz. Below 96 kHz its four phases are used. Below 192 kHz the signal is oversampled by 2x with
+  the phases 0 and 2 of the same filter, which interpolate the same points. Above that the sample peak is measured.
+  The Annex attenuates the input by 12.04 dB to get headroom in fixed point. That is not needed with floats.
+
+  The filters work on whole blocks with the phase loop outside the sample loop. This way the inner loops are plain
+  multiply and add over contiguous memory and the compiler is able to vectorize them.
+*/
+
+class TruePeakDetector {
+ public:
+  TruePeakDetector() = default;
+  TruePeakDetector(const TruePeakDetector&) = delete;
+  auto operator=(const TruePeakDetector&) -> TruePeakDetector& = delete;
+  TruePeakDetector(const TruePeakDetector&&) = delete;
+  auto operator=(const TruePeakDetector&&) -> TruePeakDetector& = delete;
+  ~TruePeakDetector() = default;
+
+  static constexpr uint taps_per_phase = 12U;
+
+  static constexpr uint max_factor = 4U;
+
+  /*
+    It has to be called when the rate or the block size change. A new block size only resizes the buffers. The
+    filters are rebuilt and the held peaks reset only when the rate changes.
+  */
+
+  void setup(const uint& rate, const uint& block_size);
+
+  void process(std::span<const float> left, std::span<const float> right);
+
+  void reset();
+
+  // Linear values. They are the largest true peak measured since the last reset
+
+  [[nodiscard]] auto get_true_peak_left() const -> double;
+
+  [[nodiscard]] auto get_true_peak_right() const -> double;
+
+  [[nodiscard]] auto get_factor() const -> uint;
+
+  [[nodiscard]] auto get_memory_usage() const -> size_t;
+
+ private:
+  // ITU-R BS.1770-4 Annex 2. Each row is one phase, in the order of the coefficients of the Annex
+
+  static constexpr std::array<std::array<float, taps_per_phase>, max_factor> bs1770_coefficients = {{
+      {0.0017089843750F, 0.0109863281250F, -0.0196533203125F, 0.0332031250000F, -0.0594482421875F, 0.1373291015625F,
+       0.9721679687500F, -0.1022949218750F, 0.0476074218750F, -0.0266113281250F, 0.0148925781250F, -0.0083007812500F},
+      {-0.0291748046875F, 0.0292968750000F, -0.0517578125000F, 0.0891113281250F, -0.1665039062500F, 0.4650878906250F,
+       0.7797851562500F, -0.2003173828125F, 0.1015625000000F, -0.0582275390625F, 0.0330810546875F, -0.0189208984375F},
+      {-0.0189208984375F, 0.0330810546875F, -0.0582275390625F, 0.1015625000000F, -0.2003173828125F, 0.7797851562500F,
+       0.4650878906250F, -0.1665039062500F, 0.0891113281250F, -0.0517578125000F, 0.0292968750000F, -0.0291748046875F},
+      {-0.0083007812500F, 0.0148925781250F, -0.0266113281250F, 0.0476074218750F, -0.1022949218750F, 0.9721679687500F,
+       0.1373291015625F, -0.0594482421875F, 0.0332031250000F, -0.0196533203125F, 0.0109863281250F, 0.0017089843750F},
+  }};
+
+  uint factor = 1U;
+
+  uint current_rate = 0U;
+
+  uint max_block_size = 0U;
+
+  float peak_L = 0.0F;
+  float peak_R = 0.0F;
+
+  std::array<std::array<float, taps_per_phase>, max_factor> coefficients{};
+
+  // history of taps_per_phase - 1 samples followed by the current block
+
+  std::vector<float> buffer_L, buffer_R;
+
+  std::vector<float> phase_output;
+
+  auto process_channel(std::span<const float> input, std::vector<float>& buffer) -> float;
+};
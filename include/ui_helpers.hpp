@@ -36,6 +36,7 @@
 #include <gtk/gtkstringlist.h>
 #include <gtk/gtkswitch.h>
 #include <gtk/gtktogglebutton.h>
+#include <sigc++/connection.h>
 #include <sys/types.h>
 #include <locale>
 #define FMT_HEADER_ONLY
@@ -43,6 +44,8 @@
 #include <fmt/format.h>
 #include <glib/gi18n.h>
 #include <string>
+#include <vector>
+#include "pipe_manager.hpp"
 #include "string_literal_wrapper.hpp"
 #include "util.hpp"
 
@@ -88,6 +91,11 @@ void append_to_string_list(GtkStringList* string_list, const std::string& name);
 
 void remove_from_string_list(GtkStringList* string_list, const std::string& name);
 
+// Appends the end of both effects pipelines and keeps the application output streams of the sidechain sources model
+// up to date
+
+void setup_sidechain_sources(GListStore* model, PipeManager* pm, std::vector<sigc::connection>& connections);
+
 void init_global_app_settings();
 
 void unref_global_app_settings();
@@ -28,6 +28,7 @@
 #include <array>
 #include <charconv>
 #include <cmath>
+#include <cstddef>
 #include <cstdlib>
 #include <filesystem>
 #include <functional>
@@ -112,6 +113,10 @@ auto str_contains(const std::string& haystack, const std::string& needle) -> boo
 
 auto compare_versions(const std::string& v0, const std::string& v1) -> int;
 
+auto zita_memory_usage(const uint& n_channels, const size_t& kernel_size, const uint& part_size) -> size_t;
+
+auto format_bytes(const size_t& bytes) -> std::string;
+
 void str_trim_start(std::string& str);
 void str_trim_end(std::string& str);
 void str_trim(std::string& str);
@@ -258,6 +263,16 @@ auto linspace(const T& start, const T& stop, const uint& npoints) -> std::vector
   return output;
 }
 
+// Bytes used by the storage of a container. Only the elements are counted, not what they may point to.
+template <typename T>
+auto container_bytes(const T& container) -> size_t {
+  if constexpr (requires { container.capacity(); }) {
+    return container.capacity() * sizeof(typename T::value_type);
+  } else {
+    return container.size() * sizeof(typename T::value_type);
+  }
+}
+
 // The following is not used and it was made only for reference. May be removed in the future.
 template <Number T>
 auto gsettings_key_check_number_range(GSettings* settings, const char* key, const T& v) -> bool {
@@ -0,0 +1,196 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "analyzer_taps.hpp"
+#include <fftw3.h>
+#include <gio/gio.h>
+#include <glib-object.h>
+#include <glib.h>
+#include <sys/types.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <span>
+#include <utility>
+#include <vector>
+#include "tags_app.hpp"
+#include "util.hpp"
+
+void AnalyzerTap::write(std::span<const float> left, std::span<const float> right) {
+  const auto position = write_position.load(std::memory_order_relaxed);
+
+  for (size_t n = 0U; n < left.size(); n++) {
+    ring[(position + n) & (capacity - 1U)] = 0.5F * (left[n] + right[n]);
+  }
+
+  write_position.store(position + left.size(), std::memory_order_release);
+}
+
+void AnalyzerTap::read_latest(std::span<float> output) const {
+  const auto end = write_position.load(std::memory_order_acquire);
+
+  const auto count = std::min(output.size(), capacity);
+
+  for (size_t n = 0U; n < count; n++) {
+    output[n] = ring[(end - count + n) & (capacity - 1U)];
+  }
+}
+
+AnalyzerTaps::AnalyzerTaps() : settings(g_settings_new(tags::app::id)) {
+  interval_ms = g_settings_get_int(settings, "meters-update-interval");
+
+  gconnections.push_back(g_signal_connect(settings, "changed::meters-update-interval",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                            auto* self = static_cast<AnalyzerTaps*>(user_data);
+
+                                            self->interval_ms = g_settings_get_int(settings, key);
+                                          }),
+                                          this));
+
+  real_input.resize(AnalyzerTap::capacity);
+  window.resize(AnalyzerTap::capacity);
+  output.resize(AnalyzerTap::capacity / 2U + 1U);
+
+  for (size_t n = 0U; n < window.size(); n++) {
+    // https://en.wikipedia.org/wiki/Hann_function
+
+    window[n] = 0.5F * (1.0F - std::cos(2.0F * std::numbers::pi_v<float> * static_cast<float>(n) /
+                                        static_cast<float>(window.size() - 1U)));
+  }
+
+  // fftw planning is not thread safe. Only the execution happens in the worker thread
+
+  complex_output = fftwf_alloc_complex(AnalyzerTap::capacity);
+
+  plan = fftwf_plan_dft_r2c_1d(static_cast<int>(AnalyzerTap::capacity), real_input.data(), complex_output,
+                               FFTW_ESTIMATE);
+
+  thread = std::thread(&AnalyzerTaps::run, this);
+}
+
+AnalyzerTaps::~AnalyzerTaps() {
+  for (auto& handler_id : gconnections) {
+    g_signal_handler_disconnect(settings, handler_id);
+  }
+
+  gconnections.clear();
+
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    exiting = true;
+  }
+
+  cv.notify_one();
+
+  thread.join();
+
+  fftwf_destroy_plan(plan);
+
+  fftwf_free(complex_output);
+
+  g_object_unref(settings);
+
+  util::debug("destroyed");
+}
+
+void AnalyzerTaps::add(const std::shared_ptr<AnalyzerTap>& tap, Callback callback) {
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    if (auto it = std::ranges::find(entries, tap, &Entry::tap); it != entries.end()) {
+      it->callback = std::move(callback);
+    } else {
+      entries.push_back({.tap = tap, .callback = std::move(callback)});
+    }
+  }
+
+  cv.notify_one();
+}
+
+void AnalyzerTaps::remove(const std::shared_ptr<AnalyzerTap>& tap) {
+  std::scoped_lock<std::mutex> lock(mutex);
+
+  std::erase_if(entries, [&](const auto& entry) { return entry.tap == tap; });
+}
+
+auto AnalyzerTaps::get_memory_usage() const -> size_t {
+  std::scoped_lock<std::mutex> lock(mutex);
+
+  return util::container_bytes(real_input) + util::container_bytes(window) + util::container_bytes(output) +
+         AnalyzerTap::capacity * sizeof(fftwf_complex);
+}
+
+void AnalyzerTaps::run() {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while (!exiting) {
+    // sleeping until there is something to analyze
+
+    cv.wait(lock, [this] { return exiting || !entries.empty(); });
+
+    if (exiting) {
+      break;
+    }
+
+    // the lock is released while waiting so taps can be added or removed
+
+    cv.wait_for(lock, std::chrono::milliseconds(interval_ms.load()), [this] { return exiting; });
+
+    if (exiting) {
+      break;
+    }
+
+    /*
+      The mutex stays locked while the callbacks run. This is what allows remove() to guarantee that the callback of a
+      removed tap is not running anymore.
+    */
+
+    for (const auto& entry : entries) {
+      const auto rate = entry.tap->rate.load(std::memory_order_relaxed);
+
+      if (rate == 0U || !entry.tap->enabled.load(std::memory_order_relaxed)) {
+        continue;
+      }
+
+      entry.tap->read_latest(real_input);
+
+      for (size_t n = 0U; n < real_input.size(); n++) {
+        real_input[n] *= window[n];
+      }
+
+      fftwf_execute(plan);
+
+      for (size_t i = 0U; i < output.size(); i++) {
+        float sqr = complex_output[i][0] * complex_output[i][0] + complex_output[i][1] * complex_output[i][1];
+
+        sqr /= static_cast<float>(output.size() * output.size());
+
+        output[i] = static_cast<double>(sqr);
+      }
+
+      entry.callback(rate, output.size(), output);
+    }
+  }
+}
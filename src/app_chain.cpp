@@ -0,0 +1,221 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "app_chain.hpp"
+#include <gio/gio.h>
+#include <glib-object.h>
+#include <glib.h>
+#include <spa/utils/defs.h>
+#include <algorithm>
+#include <cctype>
+#include <ranges>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "effects_base.hpp"
+#include "pipe_manager.hpp"
+#include "pipeline_type.hpp"
+#include "tags_app.hpp"
+#include "tags_pipewire.hpp"
+#include "tags_schema.hpp"
+#include "util.hpp"
+
+AppChain::AppChain(std::string key, PipeManager* pipe_manager)
+    : EffectsBase("app_" + make_id(key) + ": ",
+                  tags::schema::id_app_chain,
+                  pipe_manager,
+                  PipelineType::output,
+                  make_schema_path(key)),
+      key(std::move(key)) {
+  bypass = g_settings_get_boolean(global_settings, "bypass") != 0;
+
+  // the filters are linked when the sink shows up. See set_sink
+
+  sink.name = tags::pipewire::ee_app_chain_sink_prefix + make_id(this->key);
+
+  pm->create_app_chain_sink(sink.name, "Easy Effects " + this->key);
+
+  gconnections.push_back(g_signal_connect(settings, "changed::plugins",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                            auto* self = static_cast<AppChain*>(user_data);
+
+                                            self->set_bypass(self->bypass);
+                                          }),
+                                          this));
+
+  util::debug(log_tag + "chain created for " + this->key);
+}
+
+AppChain::~AppChain() {
+  disconnect_filters();
+
+  pm->destroy_app_chain_sink(sink.name);
+
+  util::debug(log_tag + "chain destroyed");
+}
+
+auto AppChain::make_id(const std::string& key) -> std::string {
+  std::string id;
+
+  for (const auto& c : key) {
+    id += (std::isalnum(static_cast<unsigned char>(c)) != 0) ? static_cast<char>(std::tolower(c)) : '-';
+  }
+
+  return id;
+}
+
+auto AppChain::make_schema_path(const std::string& key) -> std::string {
+  return tags::app::path_app_chains + make_id(key) + "/";
+}
+
+void AppChain::set_sink(const NodeInfo& node_info) {
+  sink = node_info;
+
+  util::debug(log_tag + sink.name + " node successfully retrieved with id " + util::to_string(sink.id));
+
+  set_bypass(bypass);
+}
+
+void AppChain::set_bypass(const bool& state) {
+  bypass = state;
+
+  disconnect_filters();
+
+  connect_filters(state);
+}
+
+void AppChain::connect_filters(const bool& bypass) {
+  if (sink.id == SPA_ID_INVALID || pm->output_device.id == SPA_ID_INVALID) {
+    util::debug(log_tag + "the chain sink or the output device is not available. Aborting the link");
+
+    return;
+  }
+
+  const auto list =
+      (bypass) ? std::vector<std::string>() : util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
+
+  uint prev_node_id = sink.id;
+
+  for (const auto& name : list) {
+    if (plugins.contains(name) && !plugins[name]->connected_to_pw) {
+      plugins[name]->start_pw_connection();
+    }
+  }
+
+  for (const auto& name : list) {
+    if (!plugins.contains(name)) {
+      continue;
+    }
+
+    // bypassed plugins are connected but not linked. See EffectsBase::update_filters_activity
+
+    if (!plugins[name]->connected_to_pw ? plugins[name]->connect_to_pw() : true) {
+      if (plugins[name]->get_bypass()) {
+        continue;
+      }
+
+      const auto next_node_id = plugins[name]->get_node_id();
+
+      const auto links = pm->link_nodes(prev_node_id, next_node_id);
+
+      list_proxies.insert(list_proxies.end(), links.begin(), links.end());
+
+      if (links.size() == 2U) {
+        prev_node_id = next_node_id;
+      } else {
+        util::warning(log_tag + "link from node " + util::to_string(prev_node_id) + " to node " +
+                      util::to_string(next_node_id) + " failed");
+      }
+    }
+  }
+
+  // the chain is mixed with the main pipeline by the output device
+
+  for (const auto& node_id : {output_level->get_node_id(), pm->output_device.id}) {
+    const auto links = pm->link_nodes(prev_node_id, node_id);
+
+    list_proxies.insert(list_proxies.end(), links.begin(), links.end());
+
+    if (links.size() == 2U) {
+      prev_node_id = node_id;
+    } else {
+      util::warning(log_tag + "link from node " + util::to_string(prev_node_id) + " to node " +
+                    util::to_string(node_id) + " failed");
+    }
+  }
+
+  // the probes come after the whole chain so the sidechain cycle check can see it
+
+  for (const auto& name : list) {
+    if (plugins.contains(name) && !plugins[name]->get_bypass()) {
+      plugins[name]->update_probe_links();
+    }
+  }
+
+  update_filters_activity();
+
+  update_shared_lookahead();
+}
+
+void AppChain::disconnect_filters() {
+  std::set<uint> link_id_list;
+
+  const auto selected_plugins_list =
+      (bypass) ? std::vector<std::string>() : util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
+
+  for (const auto& plugin : plugins | std::views::values) {
+    for (const auto& link : pm->list_links) {
+      if (link.input_node_id == plugin->get_node_id() || link.output_node_id == plugin->get_node_id()) {
+        link_id_list.insert(link.id);
+      }
+    }
+
+    if (plugin->connected_to_pw &&
+        std::ranges::find(selected_plugins_list, plugin->name) == selected_plugins_list.end()) {
+      plugin->disconnect_from_pw();
+    }
+  }
+
+  for (const auto& link : pm->list_links) {
+    if (link.input_node_id == output_level->get_node_id() || link.output_node_id == output_level->get_node_id()) {
+      link_id_list.insert(link.id);
+    }
+  }
+
+  for (const auto& id : link_id_list) {
+    pm->destroy_object(static_cast<int>(id));
+  }
+
+  pm->destroy_links(list_proxies);
+
+  list_proxies.clear();
+}
+
+auto AppChain::get_chain_source_id() -> uint {
+  return (bypass) ? SPA_ID_INVALID : sink.id;
+}
+
+auto AppChain::get_chain_sink_id() -> uint {
+  return output_level->get_node_id();
+}
+
+void AppChain::relink_filters() {
+  set_bypass(bypass);
+}
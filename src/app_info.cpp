@@ -211,15 +211,11 @@ void on_enable(GtkCheckButton* btn, AppInfo* self) {
 }
 
 void on_volume_changed(GtkSpinButton* sbtn, AppInfo* self) {
-  auto vol = static_cast<float>(gtk_spin_button_get_value(sbtn)) / 100.0F;
+  auto* pm = self->data->application->pm;
 
-  if (g_settings_get_boolean(self->app_settings, "use-cubic-volumes") != 0) {
-    vol = vol * vol * vol;
-  }
+  const auto vol = pm->slider_to_volume(static_cast<float>(gtk_spin_button_get_value(sbtn)) / 100.0F);
 
-  if (self->data->info.proxy != nullptr) {
-    self->data->application->pm->set_node_volume(self->data->info.proxy, self->data->info.n_volume_channels, vol);
-  }
+  pm->set_node_volume(self->data->info.serial, self->data->info.n_volume_channels, vol);
 }
 
 void on_mute(GtkToggleButton* btn, AppInfo* self) {
@@ -231,9 +227,7 @@ void on_mute(GtkToggleButton* btn, AppInfo* self) {
     gtk_button_set_icon_name(GTK_BUTTON(btn), "audio-volume-high-symbolic");
   }
 
-  if (self->data->info.proxy != nullptr) {
-    self->data->application->pm->set_node_mute(self->data->info.proxy, state != 0);
-  }
+  self->data->application->pm->set_node_mute(self->data->info.serial, state != 0);
 }
 
 void on_blocklist(GtkCheckButton* btn, AppInfo* self) {
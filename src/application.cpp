@@ -27,6 +27,7 @@
 #include <spa/param/param.h>
 #include <spa/utils/defs.h>
 #include <array>
+#include <cstddef>
 #include <cstdlib>
 #include <iostream>
 #include <ostream>
@@ -34,7 +35,10 @@
 #include <thread>
 #include "application_ui.hpp"
 #include "config.h"
+#include "lv2_wrapper.hpp"
+#include "meters_export.hpp"
 #include "pipe_manager.hpp"
+#include "plugin_base.hpp"
 #include "pipe_objects.hpp"
 #include "preferences_window.hpp"
 #include "preset_type.hpp"
@@ -51,6 +55,8 @@ namespace app {
 
 using namespace std::string_literals;
 
+constexpr auto memory_check_interval = 5U;  // seconds
+
 // NOLINTNEXTLINE
 G_DEFINE_TYPE(Application, application, ADW_TYPE_APPLICATION)
 
@@ -76,28 +82,104 @@ void update_bypass_state(Application* self) {
   util::info(((state) != 0 ? "enabling" : "disabling") + " global bypass"s);
 }
 
+void check_memory_usage(Application* self) {
+  const auto total = self->soe->broadcast_memory_usage() + self->sie->broadcast_memory_usage() +
+                     self->pm->get_memory_usage() + self->analyzer_taps->get_memory_usage();
+
+  const auto budget = static_cast<size_t>(g_settings_get_int(self->settings, "memory-budget")) * 1024U * 1024U;
+
+  if (budget == 0U || total <= budget) {
+    self->data->over_memory_budget = false;
+
+    return;
+  }
+
+  // the caches are released once each time the budget is crossed. Doing it on every check would only rebuild them
+
+  if (self->data->over_memory_budget) {
+    return;
+  }
+
+  util::warning("memory usage of " + util::format_bytes(total) + " is above the budget of " +
+                util::format_bytes(budget) + ". Releasing cached data.");
+
+  self->data->over_memory_budget = true;
+
+  self->soe->release_caches();
+  self->sie->release_caches();
+}
+
 void on_startup(GApplication* gapp) {
   G_APPLICATION_CLASS(application_parent_class)->startup(gapp);
 
   auto* self = EE_APP(gapp);
 
+  // The LV2 plugins discovery runs in a worker thread while we connect to PipeWire
+
+  lv2::preload_world();
+
   self->data = new Data();
 
   self->sie_settings = g_settings_new(tags::schema::id_input);
   self->soe_settings = g_settings_new(tags::schema::id_output);
 
-  self->pm = new PipeManager();
-  self->soe = new StreamOutputEffects(self->pm);
-  self->sie = new StreamInputEffects(self->pm);
-
   if (self->settings == nullptr) {
     self->settings = g_settings_new(tags::app::id);
   }
 
+  // Read only once. Switching between the null source and the filter requires a restart
+
+  PipeManager::ee_source_is_filter = g_settings_get_boolean(self->settings, "virtual-source-filter") != 0;
+
+  self->pm = new PipeManager();
+
+  self->meters_export = new MetersExport();
+
+  PluginBase::meters_export = self->meters_export;
+
+  self->analyzer_taps = new AnalyzerTaps();
+
+  EffectsBase::analyzer_taps = self->analyzer_taps;
+
+  self->soe = new StreamOutputEffects(self->pm);
+  self->sie = new StreamInputEffects(self->pm);
+
   if (self->presets_manager == nullptr) {
     self->presets_manager = new PresetsManager();
   }
 
+  self->data->connections.push_back(
+      self->soe->load_app_chain_preset.connect([=](const std::string preset_name, const std::string base_path) {
+        self->presets_manager->load_app_chain_preset(preset_name, base_path);
+      }));
+
+  self->data->connections.push_back(self->presets_manager->crossfade_requested.connect(
+      [=](const PresetType preset_type, const std::string preset_file) {
+        if (preset_type == PresetType::output) {
+          self->soe->crossfade_to_preset(preset_file);
+        } else {
+          self->sie->crossfade_to_preset(preset_file);
+        }
+      }));
+
+  self->data->connections.push_back(
+      self->soe->apply_preset.connect([=](const std::string preset_file, const std::string base_path) {
+        return self->presets_manager->apply_preset_file(PresetType::output, preset_file, base_path);
+      }));
+
+  self->data->connections.push_back(
+      self->sie->apply_preset.connect([=](const std::string preset_file, const std::string base_path) {
+        return self->presets_manager->apply_preset_file(PresetType::input, preset_file, base_path);
+      }));
+
+  self->data->connections.push_back(self->soe->preset_failed.connect([=](const std::string preset_file) {
+    self->presets_manager->on_deferred_preset_failed(PresetType::output, preset_file);
+  }));
+
+  self->data->connections.push_back(self->sie->preset_failed.connect([=](const std::string preset_file) {
+    self->presets_manager->on_deferred_preset_failed(PresetType::input, preset_file);
+  }));
+
   PipeManager::exclude_monitor_stream = g_settings_get_boolean(self->settings, "exclude-monitor-streams") != 0;
 
   self->data->connections.push_back(self->pm->new_default_sink_name.connect([=](const std::string name) {
@@ -249,6 +331,13 @@ void on_startup(GApplication* gapp) {
 
   update_bypass_state(self);
 
+  self->data->memory_timeout_id = g_timeout_add_seconds(memory_check_interval, GSourceFunc(+[](Application* self) {
+                                                          check_memory_usage(self);
+
+                                                          return G_SOURCE_CONTINUE;
+                                                        }),
+                                                        self);
+
   if ((g_application_get_flags(gapp) & G_APPLICATION_IS_SERVICE) != 0) {
     g_application_hold(gapp);
   }
@@ -413,6 +502,10 @@ void application_class_init(ApplicationClass* klass) {
 
     auto* self = EE_APP(gapp);
 
+    if (self->data->memory_timeout_id != 0U) {
+      g_source_remove(self->data->memory_timeout_id);
+    }
+
     for (auto& c : self->data->connections) {
       c.disconnect();
     }
@@ -443,12 +536,22 @@ void application_class_init(ApplicationClass* klass) {
     delete self->presets_manager;
     delete self->sie;
     delete self->soe;
+
+    PluginBase::meters_export = nullptr;
+    EffectsBase::analyzer_taps = nullptr;
+
+    delete self->meters_export;
+    delete self->analyzer_taps;
     delete self->pm;
 
+    lv2::free_world();
+
     self->data = nullptr;
     self->presets_manager = nullptr;
     self->sie = nullptr;
     self->soe = nullptr;
+    self->meters_export = nullptr;
+    self->analyzer_taps = nullptr;
     self->pm = nullptr;
 
     util::debug("Shutting down...");
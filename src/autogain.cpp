@@ -45,16 +45,20 @@ AutoGain::AutoGain(const std::string& tag,
                  schema,
                  schema_path,
                  pipe_manager,
-                 pipe_type),
-      target(g_settings_get_double(settings, "target")),
-      silence_threshold(g_settings_get_double(settings, "silence-threshold")) {
-  reference = parse_reference_key(util::gsettings_get_string(settings, "reference"));
+                 pipe_type) {
+  params.update([this](Params& p) {
+    p.target = g_settings_get_double(settings, "target");
+    p.silence_threshold = g_settings_get_double(settings, "silence-threshold");
+    p.reference = parse_reference_key(util::gsettings_get_string(settings, "reference"));
+  });
 
   gconnections.push_back(g_signal_connect(settings, "changed::target",
                                           G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                                             auto* self = static_cast<AutoGain*>(user_data);
 
-                                            self->target = g_settings_get_double(settings, key);
+                                            const auto v = g_settings_get_double(settings, key);
+
+                                            self->params.update([&](Params& p) { p.target = v; });
                                           }),
                                           this));
 
@@ -62,7 +66,9 @@ AutoGain::AutoGain(const std::string& tag,
                                           G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                                             auto* self = static_cast<AutoGain*>(user_data);
 
-                                            self->silence_threshold = g_settings_get_double(settings, key);
+                                            const auto v = g_settings_get_double(settings, key);
+
+                                            self->params.update([&](Params& p) { p.silence_threshold = v; });
                                           }),
                                           this));
 
@@ -102,7 +108,9 @@ AutoGain::AutoGain(const std::string& tag,
       settings, "changed::reference", G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
         auto* self = static_cast<AutoGain*>(user_data);
 
-        self->reference = parse_reference_key(util::gsettings_get_string(settings, key));
+        const auto v = parse_reference_key(util::gsettings_get_string(settings, key));
+
+        self->params.update([&](Params& p) { p.reference = v; });
       }),
       this));
 
@@ -228,6 +236,8 @@ void AutoGain::process(std::span<float>& left_in,
                        std::span<float>& right_out) {
   std::scoped_lock<std::mutex> lock(data_mutex);
 
+  const auto& p = params.acquire();
+
   if (bypass || !ebur128_ready) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
     std::copy(right_in.begin(), right_in.end(), right_out.begin());
@@ -297,7 +307,7 @@ void AutoGain::process(std::span<float>& left_in,
     failed = true;
   }
 
-  if (momentary > silence_threshold && !failed) {
+  if (momentary > p.silence_threshold && !failed) {
     double peak_L = 0.0;
     double peak_R = 0.0;
 
@@ -310,7 +320,7 @@ void AutoGain::process(std::span<float>& left_in,
     }
 
     if (!failed) {
-      switch (reference) {
+      switch (p.reference) {
         case Reference::momentary: {
           loudness = momentary;
 
@@ -360,7 +370,7 @@ void AutoGain::process(std::span<float>& left_in,
         }
       }
 
-      const double diff = target - loudness;
+      const double diff = p.target - loudness;
 
       // 10^(diff/20). The way below should be faster than using pow
       const double gain = std::exp((diff / 20.0) * std::log(10.0));
@@ -394,6 +404,13 @@ void AutoGain::process(std::span<float>& left_in,
     if (send_notifications) {
       results.emit(loudness, internal_output_gain, momentary, shortterm, global, relative, range);
 
+      meter_values = {static_cast<float>(loudness), static_cast<float>(internal_output_gain),
+                      static_cast<float>(momentary), static_cast<float>(shortterm),
+                      static_cast<float>(global),    static_cast<float>(relative),
+                      static_cast<float>(range)};
+
+      n_meter_values = 7U;
+
       notify();
     }
   }
@@ -402,3 +419,7 @@ void AutoGain::process(std::span<float>& left_in,
 auto AutoGain::get_latency_seconds() -> float {
   return 0.0F;
 }
+
+auto AutoGain::count_memory_usage() -> size_t {
+  return PluginBase::count_memory_usage() + util::container_bytes(data);
+}
@@ -28,7 +28,6 @@
 #include <string>
 #include "lv2_wrapper.hpp"
 #include "pipe_manager.hpp"
-#include "pipe_objects.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
@@ -121,7 +120,24 @@ Compressor::Compressor(const std::string& tag,
 
   lv2_wrapper->bind_key_double_db<"cwt", "wet", false>(settings);
 
+  // it overrides some of the ports bound above
+
+  setup_shared_lookahead({.lookahead_key = "sidechain-lookahead",
+                          .lookahead_port = "sla",
+                          .sidechain_key = "sidechain-type",
+                          .sidechain_port = "sct",
+                          .read_ahead_value = "Feed-forward",
+                          .external_sidechain = 2,
+                          .preamp_key = "sidechain-preamp",
+                          .preamp_port = "scp"});
+
   setup_input_output_gain();
+
+  if (package_installed) {
+    latency_port_index = lv2_wrapper->get_control_port_index("out_latency");
+
+    meter_ports = lv2_wrapper->get_control_port_indices(meter_port_symbols);
+  }
 }
 
 Compressor::~Compressor() {
@@ -172,7 +188,7 @@ void Compressor::process(std::span<float>& left_in,
    This plugin gives the latency in number of samples
  */
 
-  const auto lv = static_cast<uint>(lv2_wrapper->get_control_port_value("out_latency"));
+  const auto lv = static_cast<uint>(lv2_wrapper->get_control_port_value(latency_port_index));
 
   if (latency_n_frames != lv) {
     latency_n_frames = lv;
@@ -196,17 +212,12 @@ void Compressor::process(std::span<float>& left_in,
     get_peaks(left_in, right_in, left_out, right_out);
 
     if (send_notifications) {
-      reduction_port_value =
-          0.5F * (lv2_wrapper->get_control_port_value("rlm_l") + lv2_wrapper->get_control_port_value("rlm_r"));
+      lv2_wrapper->get_control_port_values(meter_ports, meter_port_values);
 
-      sidechain_port_value =
-          0.5F * (lv2_wrapper->get_control_port_value("slm_l") + lv2_wrapper->get_control_port_value("slm_r"));
-
-      curve_port_value =
-          0.5F * (lv2_wrapper->get_control_port_value("clm_l") + lv2_wrapper->get_control_port_value("clm_r"));
-
-      envelope_port_value =
-          0.5F * (lv2_wrapper->get_control_port_value("elm_l") + lv2_wrapper->get_control_port_value("elm_r"));
+      reduction_port_value = 0.5F * (meter_port_values[0] + meter_port_values[1]);
+      sidechain_port_value = 0.5F * (meter_port_values[2] + meter_port_values[3]);
+      curve_port_value = 0.5F * (meter_port_values[4] + meter_port_values[5]);
+      envelope_port_value = 0.5F * (meter_port_values[6] + meter_port_values[7]);
 
       reduction.emit(reduction_port_value);
       sidechain.emit(sidechain_port_value);
@@ -219,33 +230,27 @@ void Compressor::process(std::span<float>& left_in,
 }
 
 void Compressor::update_sidechain_links(const std::string& key) {
-  if (util::gsettings_get_string(settings, "sidechain-type") != "External") {
+  if (reads_ahead()) {
     pm->destroy_links(list_proxies);
 
-    list_proxies.clear();
+    list_proxies = link_read_ahead_source();
 
     return;
   }
 
-  const auto device_name = util::gsettings_get_string(settings, "sidechain-input-device");
-
-  NodeInfo input_device = pm->ee_source_node;
+  if (util::gsettings_get_string(settings, "sidechain-type") != "External") {
+    pm->destroy_links(list_proxies);
 
-  for (const auto& [serial, node] : pm->node_map) {
-    if (node.name == device_name) {
-      input_device = node;
+    list_proxies.clear();
 
-      break;
-    }
+    return;
   }
 
-  pm->destroy_links(list_proxies);
+  const auto device_name = util::gsettings_get_string(settings, "sidechain-input-device");
 
-  list_proxies.clear();
+  pm->destroy_links(list_proxies);
 
-  for (const auto& link : pm->link_nodes(input_device.id, get_node_id(), true)) {
-    list_proxies.push_back(link);
-  }
+  list_proxies = pm->link_sidechain(device_name, get_node_id());
 }
 
 void Compressor::update_probe_links() {
@@ -178,7 +178,8 @@ void setup(CompressorBox* self,
 
     if (node.media_class == tags::pipewire::media_class::source ||
         node.media_class == tags::pipewire::media_class::virtual_source ||
-        node.media_role == tags::pipewire::media_role::dsp) {
+        node.media_role == tags::pipewire::media_role::dsp ||
+        node.media_class == tags::pipewire::media_class::output_stream) {
       auto* holder = ui::holders::create(node);
 
       g_list_store_append(self->input_devices_model, holder);
@@ -187,6 +188,8 @@ void setup(CompressorBox* self,
     }
   }
 
+  ui::setup_sidechain_sources(self->input_devices_model, pm, self->data->connections);
+
   self->data->connections.push_back(compressor->input_level.connect([=](const float left, const float right) {
     g_object_ref(self);
 
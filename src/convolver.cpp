@@ -541,6 +541,37 @@ auto Convolver::get_latency_seconds() -> float {
   return this->latency_value;
 }
 
+auto Convolver::count_memory_usage() -> size_t {
+  auto bytes = PluginBase::count_memory_usage() + util::container_bytes(kernel_L) + util::container_bytes(kernel_R) +
+               util::container_bytes(original_kernel_L) + util::container_bytes(original_kernel_R) +
+               util::container_bytes(data_L) + util::container_bytes(data_R) + util::container_bytes(deque_out_L) +
+               util::container_bytes(deque_out_R);
+
+  if (zita_ready) {
+    bytes += util::zita_memory_usage(2U, original_kernel_L.size(), get_zita_buffer_size());
+  }
+
+  return bytes;
+}
+
+void Convolver::release_caches() {
+  // like get_memory_usage the main thread does not wait for the realtime thread or for a kernel being prepared
+
+  std::unique_lock<std::mutex> lock(data_mutex, std::try_to_lock);
+
+  /*
+    zita-convolver has its own copy of the impulse response. The working copy of the kernel is rebuilt from the
+    original one whenever it is needed again.
+  */
+
+  if (!lock.owns_lock() || !ready) {
+    return;
+  }
+
+  std::vector<float>().swap(kernel_L);
+  std::vector<float>().swap(kernel_R);
+}
+
 void Convolver::prepare_kernel() {
   if (n_samples == 0U || rate == 0U) {
     return;
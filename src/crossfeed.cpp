@@ -23,7 +23,6 @@
 #include <glib.h>
 #include <algorithm>
 #include <cstddef>
-#include <mutex>
 #include <span>
 #include <string>
 #include "pipe_manager.hpp"
@@ -43,17 +42,23 @@ Crossfeed::Crossfeed(const std::string& tag,
                  schema_path,
                  pipe_manager,
                  pipe_type) {
-  bs2b.set_level_fcut(g_settings_get_int(settings, "fcut"));
+  applied.fcut = g_settings_get_int(settings, "fcut");
+  applied.feed = 10 * static_cast<int>(g_settings_get_double(settings, "feed"));
 
-  bs2b.set_level_feed(10 * static_cast<int>(g_settings_get_double(settings, "feed")));
+  bs2b.set_level_fcut(applied.fcut);
+  bs2b.set_level_feed(applied.feed);
+
+  params.update([&](Params& p) { p = applied; });
+
+  // bs2b is not touched here. The realtime thread applies the new values when the next quantum starts
 
   gconnections.push_back(g_signal_connect(settings, "changed::fcut",
                                           G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                                             auto* self = static_cast<Crossfeed*>(user_data);
 
-                                            std::scoped_lock<std::mutex> lock(self->data_mutex);
+                                            const auto v = g_settings_get_int(settings, key);
 
-                                            self->bs2b.set_level_fcut(g_settings_get_int(settings, key));
+                                            self->params.update([&](Params& p) { p.fcut = v; });
                                           }),
                                           this));
 
@@ -61,9 +66,9 @@ Crossfeed::Crossfeed(const std::string& tag,
       g_signal_connect(settings, "changed::feed", G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                          auto* self = static_cast<Crossfeed*>(user_data);
 
-                         std::scoped_lock<std::mutex> lock(self->data_mutex);
+                         const auto v = 10 * static_cast<int>(g_settings_get_double(settings, key));
 
-                         self->bs2b.set_level_feed(10 * static_cast<int>(g_settings_get_double(settings, key)));
+                         self->params.update([&](Params& p) { p.feed = v; });
                        }),
                        this));
 
@@ -79,8 +84,6 @@ Crossfeed::~Crossfeed() {
 }
 
 void Crossfeed::setup() {
-  std::scoped_lock<std::mutex> lock(data_mutex);
-
   data.resize(2U * static_cast<size_t>(n_samples));
 
   if (rate != bs2b.get_srate()) {
@@ -92,7 +95,19 @@ void Crossfeed::process(std::span<float>& left_in,
                         std::span<float>& right_in,
                         std::span<float>& left_out,
                         std::span<float>& right_out) {
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  const auto& p = params.acquire();
+
+  if (p.fcut != applied.fcut) {
+    applied.fcut = p.fcut;
+
+    bs2b.set_level_fcut(applied.fcut);
+  }
+
+  if (p.feed != applied.feed) {
+    applied.feed = p.feed;
+
+    bs2b.set_level_feed(applied.feed);
+  }
 
   if (bypass) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
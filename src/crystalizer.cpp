@@ -330,3 +330,20 @@ void Crystalizer::bind_band(const int& n) {
 auto Crystalizer::get_latency_seconds() -> float {
   return this->latency_value;
 }
+
+auto Crystalizer::count_memory_usage() -> size_t {
+  auto bytes = PluginBase::count_memory_usage() + util::container_bytes(data_L) + util::container_bytes(data_R) +
+               util::container_bytes(deque_out_L) + util::container_bytes(deque_out_R);
+
+  for (uint n = 0U; n < nbands; n++) {
+    bytes += util::container_bytes(band_data_L.at(n)) + util::container_bytes(band_data_R.at(n)) +
+             util::container_bytes(band_gain.at(n)) + util::container_bytes(band_second_derivative_L.at(n)) +
+             util::container_bytes(band_second_derivative_R.at(n));
+
+    if (filters.at(n) != nullptr) {
+      bytes += filters.at(n)->get_memory_usage();
+    }
+  }
+
+  return bytes;
+}
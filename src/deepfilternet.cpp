@@ -19,6 +19,7 @@
 
 #include "deepfilternet.hpp"
 #include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <span>
@@ -209,3 +210,9 @@ void DeepFilterNet::process(std::span<float>& left_in,
 auto DeepFilterNet::get_latency_seconds() -> float {
   return 0.02F + 1.0F / rate;
 }
+
+auto DeepFilterNet::count_memory_usage() -> size_t {
+  return PluginBase::count_memory_usage() + util::container_bytes(resampled_outL) +
+         util::container_bytes(resampled_outR) + util::container_bytes(carryover_l) +
+         util::container_bytes(carryover_r);
+}
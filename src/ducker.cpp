@@ -0,0 +1,84 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ducker.hpp"
+#include <sys/types.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "util.hpp"
+
+namespace {
+
+auto now_ms() -> int64_t {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+void Ducker::set_voice_detected(const bool& state) {
+  voice_state.store(state, std::memory_order_relaxed);
+
+  voice_time_ms.store(now_ms(), std::memory_order_relaxed);
+}
+
+auto Ducker::voice_detected() -> bool {
+  return voice_state.load(std::memory_order_relaxed) &&
+         now_ms() - voice_time_ms.load(std::memory_order_relaxed) < voice_timeout_ms;
+}
+
+void Ducker::setup(const uint& rate) {
+  this->rate = rate;
+}
+
+void Ducker::process(std::span<float> left, std::span<float> right) {
+  if (rate == 0U) {
+    return;
+  }
+
+  const auto target = (enabled.load(std::memory_order_relaxed) && voice_detected())
+                          ? util::db_to_linear(reduction_db.load(std::memory_order_relaxed))
+                          : 1.0F;
+
+  if (gain == target) {
+    return;
+  }
+
+  // one pole smoothing. The time constant is the attack when the gain goes down and the release when it goes up
+
+  const auto time_ms = (target < gain) ? attack_ms.load(std::memory_order_relaxed)
+                                       : release_ms.load(std::memory_order_relaxed);
+
+  const auto coefficient = std::exp(-1000.0F / (time_ms * static_cast<float>(rate)));
+
+  for (size_t n = 0U; n < left.size(); n++) {
+    gain = target + coefficient * (gain - target);
+
+    left[n] *= gain;
+    right[n] *= gain;
+  }
+
+  if (std::fabs(gain - target) < 1e-5F) {
+    gain = target;
+  }
+}
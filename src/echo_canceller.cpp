@@ -33,6 +33,7 @@
 #include <string>
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
+#include "probe_aligner.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
 
@@ -134,6 +135,8 @@ void EchoCanceller::setup() {
 
   latency_n_frames = 0U;
 
+  probe_aligner.setup(rate);
+
   init_speex();
 }
 
@@ -156,6 +159,8 @@ void EchoCanceller::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
+  probe_aligner.process(left_in, probe_left, probe_right);
+
   for (size_t j = 0U; j < left_in.size(); j++) {
     data_L[j] = static_cast<spx_int16_t>(left_in[j] * (SHRT_MAX + 1));
     data_R[j] = static_cast<spx_int16_t>(right_in[j] * (SHRT_MAX + 1));
@@ -224,6 +229,10 @@ void EchoCanceller::init_speex() {
 
   const uint filter_length = static_cast<uint>(0.001F * static_cast<float>(filter_length_ms * rate));
 
+  // a quarter of the window before the echo and the rest after it
+
+  probe_aligner.set_margin_ms(filter_length_ms / 4U);
+
   util::debug(log_tag + name + " filter length: " + util::to_string(filter_length));
 
   if (echo_state_L != nullptr) {
@@ -292,3 +301,9 @@ void EchoCanceller::free_speex() {
 auto EchoCanceller::get_latency_seconds() -> float {
   return latency_value;
 }
+
+auto EchoCanceller::count_memory_usage() -> size_t {
+  return PluginBase::count_memory_usage() + util::container_bytes(data_L) + util::container_bytes(data_R) +
+         util::container_bytes(probe_mono) + util::container_bytes(filtered_L) + util::container_bytes(filtered_R) +
+         probe_aligner.get_memory_usage();
+}
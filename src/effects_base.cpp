@@ -21,12 +21,17 @@
 #include <gio/gio.h>
 #include <glib-object.h>
 #include <glib.h>
+#include <spa/utils/defs.h>
+#include <sys/types.h>
 #include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <ranges>
 #include <string>
 #include <utility>
+#include <vector>
 #include "autogain.hpp"
 #include "bass_enhancer.hpp"
 #include "bass_loudness.hpp"
@@ -52,7 +57,9 @@
 #include "output_level.hpp"
 #include "pipe_manager.hpp"
 #include "pitch.hpp"
+#include "pipeline_type.hpp"
 #include "plugin_base.hpp"
+#include "preset_stage.hpp"
 #include "reverb.hpp"
 #include "rnnoise.hpp"
 #include "spectrum.hpp"
@@ -63,17 +70,26 @@
 #include "tags_schema.hpp"
 #include "util.hpp"
 
-EffectsBase::EffectsBase(std::string tag, const std::string& schema, PipeManager* pipe_manager, PipelineType pipe_type)
+EffectsBase::EffectsBase(std::string tag,
+                         const std::string& schema,
+                         PipeManager* pipe_manager,
+                         PipelineType pipe_type,
+                         const std::string& schema_path)
     : log_tag(std::move(tag)),
       pm(pipe_manager),
       pipeline_type(pipe_type),
-      settings(g_settings_new(schema.c_str())),
+      settings(schema_path.empty() ? g_settings_new(schema.c_str())
+                                   : g_settings_new_with_path(schema.c_str(), schema_path.c_str())),
       global_settings(g_settings_new(tags::app::id)) {
   using namespace std::string_literals;
 
-  schema_base_path = "/" + schema + "/";
+  if (schema_path.empty()) {
+    schema_base_path = "/" + schema + "/";
 
-  std::replace(schema_base_path.begin(), schema_base_path.end(), '.', '/');
+    std::replace(schema_base_path.begin(), schema_base_path.end(), '.', '/');
+  } else {
+    schema_base_path = schema_path;
+  }
 
   output_level = std::make_shared<OutputLevel>(log_tag, tags::schema::output_level::id,
                                                schema_base_path + "outputlevel/", pm, pipeline_type);
@@ -81,12 +97,27 @@ EffectsBase::EffectsBase(std::string tag, const std::string& schema, PipeManager
   spectrum = std::make_shared<Spectrum>(log_tag, tags::schema::spectrum::id, tags::app::path + "/spectrum/"s, pm,
                                         pipeline_type);
 
-  if (!output_level->connected_to_pw) {
-    output_level->connect_to_pw();
+  // relocated pipelines like the preset stage are never the virtual source
+
+  if (pipeline_type == PipelineType::input && PipeManager::ee_source_is_filter && schema_path.empty()) {
+    output_level->expose_as_virtual_source();
   }
 
-  if (!spectrum->connected_to_pw) {
-    spectrum->connect_to_pw();
+  // The application chains do not show a spectrum, so they do not need its node. The preset stage fades with it
+
+  const auto needs_spectrum_node = !schema_base_path.starts_with(tags::app::path_app_chains);
+
+  // A filter that could not be connected is not waited for. Linking it fails with a warning and the chain goes on
+
+  const auto output_level_started = output_level->start_pw_connection();
+  const auto spectrum_started = needs_spectrum_node && spectrum->start_pw_connection();
+
+  if (output_level_started && !output_level->finish_pw_connection()) {
+    util::warning(log_tag + "the output level filter could not be connected to PipeWire");
+  }
+
+  if (spectrum_started && !spectrum->finish_pw_connection()) {
+    util::warning(log_tag + "the spectrum filter could not be connected to PipeWire");
   }
 
   create_filters_if_necessary();
@@ -98,6 +129,16 @@ EffectsBase::EffectsBase(std::string tag, const std::string& schema, PipeManager
                                             self->create_filters_if_necessary();
 
                                             self->broadcast_pipeline_latency();
+
+                                            self->update_spectrum_tap();
+                                          }),
+                                          this));
+
+  gconnections.push_back(g_signal_connect(settings, "changed::spectrum-tap",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                            auto* self = static_cast<EffectsBase*>(user_data);
+
+                                            self->update_spectrum_tap();
                                           }),
                                           this));
 
@@ -115,6 +156,30 @@ EffectsBase::EffectsBase(std::string tag, const std::string& schema, PipeManager
                                                  }),
                                                  this));
 
+  gconnections_global.push_back(g_signal_connect(global_settings, "changed::export-meters",
+                                                 G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                                   auto* self = static_cast<EffectsBase*>(user_data);
+
+                                                   const auto state = g_settings_get_boolean(settings, key) != 0;
+
+                                                   self->output_level->set_export_meters(state);
+
+                                                   self->set_export_spectrum(state);
+
+                                                   for (auto& plugin : self->plugins | std::views::values) {
+                                                     plugin->set_export_meters(state);
+                                                   }
+                                                 }),
+                                                 this));
+
+  gconnections_global.push_back(g_signal_connect(global_settings, "changed::shared-lookahead",
+                                                 G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                                   auto* self = static_cast<EffectsBase*>(user_data);
+
+                                                   self->update_shared_lookahead();
+                                                 }),
+                                                 this));
+
   gconnections_global.push_back(g_signal_connect(global_settings, "changed::lv2ui-update-frequency",
                                                  G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                                                    auto* self = static_cast<EffectsBase*>(user_data);
@@ -132,12 +197,31 @@ EffectsBase::EffectsBase(std::string tag, const std::string& schema, PipeManager
 
   spectrum->notification_time_window = notification_time_window;
 
+  set_export_spectrum(g_settings_get_boolean(global_settings, "export-meters") != 0);
+
+  // no point in analyzing a tap while the spectrum is neither shown nor exported
+
+  connections.push_back(spectrum->bypass_changed.connect(
+      [this](const bool state) { spectrum_tap->enabled = !state || spectrum->is_exported(); }));
+
   for (auto& plugin : plugins | std::views::values) {
     plugin->notification_time_window = notification_time_window;
   }
+
+  update_spectrum_tap();
 }
 
 EffectsBase::~EffectsBase() {
+  if (crossfade_timeout_id != 0U) {
+    g_source_remove(crossfade_timeout_id);
+  }
+
+  preset_stage.reset();
+
+  if (analyzer_taps != nullptr) {
+    analyzer_taps->remove(spectrum_tap);
+  }
+
   for (auto& c : connections) {
     c.disconnect();
   }
@@ -166,6 +250,8 @@ void EffectsBase::reset_settings() {
 }
 
 void EffectsBase::create_filters_if_necessary() {
+  using Type = tags::plugin_name::Type;
+
   const auto list = util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
 
   if (list.empty()) {
@@ -177,75 +263,176 @@ void EffectsBase::create_filters_if_necessary() {
       continue;
     }
 
+    const auto* descriptor = tags::plugin_name::find(name);
+
+    if (descriptor == nullptr) {
+      util::warning(log_tag + name + " is not a known effect");
+
+      continue;
+    }
+
     auto instance_id = util::to_string(tags::plugin_name::get_id(name));
 
-    auto path = schema_base_path + tags::plugin_name::get_base_name(name) + "/" + instance_id + "/";
+    auto path = schema_base_path + descriptor->base_name + "/" + instance_id + "/";
 
     path.erase(std::remove(path.begin(), path.end(), '_'), path.end());
 
+    const auto* schema = descriptor->schema;
+
     std::shared_ptr<PluginBase> filter;
 
-    if (name.starts_with(tags::plugin_name::autogain)) {
-      filter = std::make_shared<AutoGain>(log_tag, tags::schema::autogain::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::bass_enhancer)) {
-      filter = std::make_shared<BassEnhancer>(log_tag, tags::schema::bass_enhancer::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::bass_loudness)) {
-      filter = std::make_shared<BassLoudness>(log_tag, tags::schema::bass_loudness::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::compressor)) {
-      filter = std::make_shared<Compressor>(log_tag, tags::schema::compressor::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::convolver)) {
-      filter = std::make_shared<Convolver>(log_tag, tags::schema::convolver::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::crossfeed)) {
-      filter = std::make_shared<Crossfeed>(log_tag, tags::schema::crossfeed::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::crystalizer)) {
-      filter = std::make_shared<Crystalizer>(log_tag, tags::schema::crystalizer::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::deepfilternet)) {
-      filter = std::make_shared<DeepFilterNet>(log_tag, tags::schema::deepfilternet::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::deesser)) {
-      filter = std::make_shared<Deesser>(log_tag, tags::schema::deesser::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::delay)) {
-      filter = std::make_shared<Delay>(log_tag, tags::schema::delay::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::echo_canceller)) {
-      filter = std::make_shared<EchoCanceller>(log_tag, tags::schema::echo_canceller::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::exciter)) {
-      filter = std::make_shared<Exciter>(log_tag, tags::schema::exciter::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::expander)) {
-      filter = std::make_shared<Expander>(log_tag, tags::schema::expander::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::equalizer)) {
-      filter = std::make_shared<Equalizer>(
-          log_tag, tags::schema::equalizer::id, path, tags::schema::equalizer::channel_id,
-          schema_base_path + "equalizer/" + instance_id + "/leftchannel/",
-          schema_base_path + "equalizer/" + instance_id + "/rightchannel/", pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::filter)) {
-      filter = std::make_shared<Filter>(log_tag, tags::schema::filter::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::gate)) {
-      filter = std::make_shared<Gate>(log_tag, tags::schema::gate::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::level_meter)) {
-      filter = std::make_shared<LevelMeter>(log_tag, tags::schema::level_meter::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::limiter)) {
-      filter = std::make_shared<Limiter>(log_tag, tags::schema::limiter::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::loudness)) {
-      filter = std::make_shared<Loudness>(log_tag, tags::schema::loudness::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::maximizer)) {
-      filter = std::make_shared<Maximizer>(log_tag, tags::schema::maximizer::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::multiband_compressor)) {
-      filter = std::make_shared<MultibandCompressor>(log_tag, tags::schema::multiband_compressor::id, path, pm,
-                                                     pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::multiband_gate)) {
-      filter = std::make_shared<MultibandGate>(log_tag, tags::schema::multiband_gate::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::pitch)) {
-      filter = std::make_shared<Pitch>(log_tag, tags::schema::pitch::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::reverb)) {
-      filter = std::make_shared<Reverb>(log_tag, tags::schema::reverb::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::rnnoise)) {
-      filter = std::make_shared<RNNoise>(log_tag, tags::schema::rnnoise::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::speex)) {
-      filter = std::make_shared<Speex>(log_tag, tags::schema::speex::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::stereo_tools)) {
-      filter = std::make_shared<StereoTools>(log_tag, tags::schema::stereo_tools::id, path, pm, pipeline_type);
+    switch (descriptor->type) {
+      case Type::autogain: {
+        filter = std::make_shared<AutoGain>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::bass_enhancer: {
+        filter = std::make_shared<BassEnhancer>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::bass_loudness: {
+        filter = std::make_shared<BassLoudness>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::compressor: {
+        filter = std::make_shared<Compressor>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::convolver: {
+        filter = std::make_shared<Convolver>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::crossfeed: {
+        filter = std::make_shared<Crossfeed>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::crystalizer: {
+        filter = std::make_shared<Crystalizer>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::deepfilternet: {
+        filter = std::make_shared<DeepFilterNet>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::deesser: {
+        filter = std::make_shared<Deesser>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::delay: {
+        filter = std::make_shared<Delay>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::echo_canceller: {
+        filter = std::make_shared<EchoCanceller>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::equalizer: {
+        filter = std::make_shared<Equalizer>(
+            log_tag, schema, path, tags::schema::equalizer::channel_id,
+            schema_base_path + "equalizer/" + instance_id + "/leftchannel/",
+            schema_base_path + "equalizer/" + instance_id + "/rightchannel/", pm, pipeline_type);
+
+        break;
+      }
+      case Type::exciter: {
+        filter = std::make_shared<Exciter>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::expander: {
+        filter = std::make_shared<Expander>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::filter: {
+        filter = std::make_shared<Filter>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::gate: {
+        filter = std::make_shared<Gate>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::level_meter: {
+        filter = std::make_shared<LevelMeter>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::limiter: {
+        filter = std::make_shared<Limiter>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::loudness: {
+        filter = std::make_shared<Loudness>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::maximizer: {
+        filter = std::make_shared<Maximizer>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::multiband_compressor: {
+        filter = std::make_shared<MultibandCompressor>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::multiband_gate: {
+        filter = std::make_shared<MultibandGate>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::pitch: {
+        filter = std::make_shared<Pitch>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::reverb: {
+        filter = std::make_shared<Reverb>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::rnnoise: {
+        filter = std::make_shared<RNNoise>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::speex: {
+        filter = std::make_shared<Speex>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+      case Type::stereo_tools: {
+        filter = std::make_shared<StereoTools>(log_tag, schema, path, pm, pipeline_type);
+
+        break;
+      }
+    }
+
+    if (descriptor->latency == tags::plugin_name::LatencyClass::variable) {
+      connections.push_back(filter->latency.connect([this]() { broadcast_pipeline_latency(); }));
     }
 
-    connections.push_back(filter->latency.connect([this]() { broadcast_pipeline_latency(); }));
+    connections.push_back(filter->bypass_changed.connect([this, name](const bool state) {
+      on_plugin_bypass_changed(name, state);
+
+      on_filters_bypass_changed();
+    }));
+
+    connections.push_back(filter->lookahead_changed.connect([this]() { update_shared_lookahead(); }));
 
     plugins.insert(std::make_pair(name, filter));
   }
@@ -266,9 +453,11 @@ void EffectsBase::remove_unused_filters() {
     if (std::ranges::find(list, key) == list.end()) {
       auto plugin = it->second;
 
-      plugin->bypass = true;
+      plugin->set_bypass(true);
       plugin->set_post_messages(false);
       plugin->latency.clear();
+      plugin->bypass_changed.clear();
+      plugin->lookahead_changed.clear();
 
       if (plugin->connected_to_pw) {
         plugin->disconnect_from_pw();
@@ -283,21 +472,38 @@ void EffectsBase::remove_unused_filters() {
 
 void EffectsBase::activate_filters() {
   for (auto& plugin : plugins | std::views::values) {
-    plugin->set_active(true);
+    if (plugin->connected_to_pw) {
+      plugin->set_active(!plugin->get_bypass());
+    }
+  }
+
+  if (spectrum->connected_to_pw) {
+    spectrum->set_active(true);
   }
 }
 
 void EffectsBase::deactivate_filters() {
   for (auto& plugin : plugins | std::views::values) {
-    plugin->set_active(false);
+    if (plugin->connected_to_pw) {
+      plugin->set_active(false);
+    }
+  }
+
+  if (spectrum->connected_to_pw) {
+    spectrum->set_active(false);
   }
 }
 
 auto EffectsBase::get_pipeline_latency() -> float {
   float total = 0.0F;
 
+  /*
+    Bypassed plugins are not linked. Plugins with a muted output run in parallel with the one that is heard, like the
+    denoisers being compared, so they do not delay it.
+  */
+
   for (const auto& name : util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"))) {
-    if (plugins.contains(name)) {
+    if (plugins.contains(name) && !plugins[name]->get_bypass() && !plugins[name]->output_muted) {
       total += plugins[name]->get_latency_seconds();
     }
   }
@@ -313,6 +519,470 @@ void EffectsBase::broadcast_pipeline_latency() {
   pipeline_latency.emit(latency_value);
 }
 
+void EffectsBase::set_export_spectrum(const bool& state) {
+  spectrum->set_export_spectrum(state && !schema_base_path.starts_with(tags::app::path_app_chains) &&
+                                !schema_base_path.starts_with(tags::app::path_preset_stage));
+
+  spectrum_tap->enabled = !spectrum->get_bypass() || spectrum->is_exported();
+}
+
+void EffectsBase::update_spectrum_tap() {
+  for (auto& plugin : plugins | std::views::values) {
+    plugin->set_analyzer_tap(nullptr, TapPoint::output);
+  }
+
+  if (analyzer_taps == nullptr) {
+    return;
+  }
+
+  const auto value = util::gsettings_get_string(settings, "spectrum-tap");
+
+  const auto separator = value.rfind(':');
+
+  const auto plugin_name = value.substr(0U, separator);
+
+  const auto list = util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
+
+  if (separator == std::string::npos || !plugins.contains(plugin_name) ||
+      std::ranges::find(list, plugin_name) == list.end()) {
+    analyzer_taps->remove(spectrum_tap);
+
+    spectrum->set_external_tap(false);
+
+    return;
+  }
+
+  const auto point = (value.substr(separator + 1U) == "input") ? TapPoint::input : TapPoint::output;
+
+  plugins[plugin_name]->set_analyzer_tap(spectrum_tap.get(), point);
+
+  /*
+    The callback runs in the analyzer thread. The chart only listens to the spectrum signals in the main thread. The
+    pipeline may be destroyed before the queued callbacks run, so they only hold a weak reference to the spectrum.
+  */
+
+  const auto weak_spectrum = std::weak_ptr<Spectrum>(spectrum);
+
+  analyzer_taps->add(spectrum_tap, [weak_spectrum](uint rate, uint, const std::vector<double>& magnitudes) {
+    util::idle_add([weak_spectrum, rate, magnitudes]() {
+      if (PipeManager::exiting) {
+        return;
+      }
+
+      if (const auto target = weak_spectrum.lock(); target != nullptr) {
+        target->show_tap_power(rate, magnitudes);
+      }
+    });
+  });
+
+  spectrum->set_external_tap(true);
+
+  util::debug(log_tag + "spectrum tap attached to " + value);
+}
+
+auto EffectsBase::broadcast_memory_usage() -> size_t {
+  size_t total = output_level->get_memory_usage() + spectrum->get_memory_usage() + sizeof(AnalyzerTap);
+
+  std::map<std::string, size_t> plugins_usage;
+
+  for (const auto& [name, plugin] : plugins) {
+    plugins_usage[name] = plugin->get_memory_usage();
+
+    total += plugins_usage[name];
+  }
+
+  if (total != last_memory_usage) {
+    last_memory_usage = total;
+
+    util::debug(log_tag + "memory usage: " + util::format_bytes(total));
+
+    for (const auto& [name, bytes] : plugins_usage) {
+      util::debug(log_tag + name + ": " + util::format_bytes(bytes));
+    }
+  }
+
+  memory_usage.emit(total);
+
+  return total;
+}
+
+void EffectsBase::release_caches() {
+  for (auto& plugin : plugins | std::views::values) {
+    plugin->release_caches();
+  }
+}
+
 auto EffectsBase::get_plugins_map() -> std::map<std::string, std::shared_ptr<PluginBase>> {
   return plugins;
 }
+
+void EffectsBase::crossfade_to_preset(const std::string& preset_file) {
+  if (crossfade_state != CrossfadeState::idle) {
+    pending_preset_file = preset_file;
+
+    return;
+  }
+
+  const auto duration_ms = g_settings_get_int(global_settings, "preset-crossfade-time");
+
+  if (duration_ms <= 0 || g_settings_get_boolean(global_settings, "bypass") != 0) {
+    apply_preset_to_pipeline(preset_file);
+
+    return;
+  }
+
+  // the stage mixes where our output goes. In the input pipeline that is our output level when it is the source
+
+  uint source_id = SPA_ID_INVALID;
+  uint mix_node_id = SPA_ID_INVALID;
+
+  if (pipeline_type == PipelineType::output) {
+    source_id = pm->ee_sink_node.id;
+    mix_node_id = pm->output_device.id;
+  } else {
+    source_id = pm->input_device.id;
+    mix_node_id = (PipeManager::ee_source_is_filter) ? output_level->get_node_id() : pm->ee_source_node.id;
+  }
+
+  // the preset is loaded before the stage exists so its filters are created only once
+
+  if (!apply_preset.emit(preset_file, PresetStage::make_schema_path(pipeline_type))) {
+    apply_preset_to_pipeline(preset_file);
+
+    return;
+  }
+
+  preset_stage = std::make_unique<PresetStage>(log_tag, pm, pipeline_type);
+
+  if (!preset_stage->connect_filters(source_id, mix_node_id)) {
+    preset_stage.reset();
+
+    apply_preset_to_pipeline(preset_file);
+
+    return;
+  }
+
+  crossfade_preset_file = preset_file;
+
+  crossfade_seconds = 0.001F * static_cast<float>(duration_ms);
+
+  crossfade_state = CrossfadeState::warmup;
+
+  schedule_crossfade_step(PresetStage::warmup_ms);
+
+  util::debug(log_tag + "crossfading to the preset " + preset_file);
+}
+
+void EffectsBase::apply_preset_to_pipeline(const std::string& preset_file) {
+  if (!apply_preset.emit(preset_file, "")) {
+    util::warning(log_tag + "the preset " + preset_file + " could not be applied");
+
+    preset_failed.emit(preset_file);
+  }
+}
+
+void EffectsBase::schedule_crossfade_step(const uint& delay_ms) {
+  crossfade_timeout_id = g_timeout_add(delay_ms, GSourceFunc(+[](EffectsBase* self) {
+                                         self->crossfade_timeout_id = 0U;
+
+                                         self->crossfade_step();
+
+                                         return G_SOURCE_REMOVE;
+                                       }),
+                                       this);
+}
+
+void EffectsBase::crossfade_step() {
+  // a few quanta are added to the fade time so the fade is over in the realtime thread
+
+  const auto fade_ms = static_cast<uint>(1000.0F * crossfade_seconds) + 50U;
+
+  switch (crossfade_state) {
+    case CrossfadeState::warmup: {
+      spectrum->fade_to(0.0F, crossfade_seconds);
+      preset_stage->spectrum->fade_to(1.0F, crossfade_seconds);
+
+      crossfade_state = CrossfadeState::to_stage;
+
+      schedule_crossfade_step(fade_ms);
+
+      break;
+    }
+    case CrossfadeState::to_stage: {
+      // only the stage is heard now. Reconfiguring our filters is not audible
+
+      apply_preset_to_pipeline(crossfade_preset_file);
+
+      crossfade_state = CrossfadeState::settle;
+
+      schedule_crossfade_step(PresetStage::warmup_ms);
+
+      break;
+    }
+    case CrossfadeState::settle: {
+      // both chains have the new preset now. Their outputs are the same, so their gains have to add up to one
+
+      spectrum->fade_to(1.0F, crossfade_seconds, PluginBase::FadeLaw::linear);
+      preset_stage->spectrum->fade_to(0.0F, crossfade_seconds, PluginBase::FadeLaw::linear);
+
+      crossfade_state = CrossfadeState::to_pipeline;
+
+      schedule_crossfade_step(fade_ms);
+
+      break;
+    }
+    case CrossfadeState::to_pipeline: {
+      preset_stage.reset();
+
+      crossfade_state = CrossfadeState::idle;
+
+      util::debug(log_tag + "crossfade to the preset " + crossfade_preset_file + " finished");
+
+      if (!pending_preset_file.empty()) {
+        const auto preset_file = pending_preset_file;
+
+        pending_preset_file.clear();
+
+        crossfade_to_preset(preset_file);
+      }
+
+      break;
+    }
+    case CrossfadeState::idle: {
+      break;
+    }
+  }
+}
+
+auto EffectsBase::is_preset_stage_node(const uint& node_id) const -> bool {
+  return preset_stage != nullptr && node_id == preset_stage->spectrum->get_node_id();
+}
+
+auto EffectsBase::get_chain_source_id() -> uint {
+  return SPA_ID_INVALID;
+}
+
+auto EffectsBase::get_chain_sink_id() -> uint {
+  return spectrum->get_node_id();
+}
+
+void EffectsBase::relink_filters() {}
+
+auto EffectsBase::is_suspended() -> bool {
+  return false;
+}
+
+void EffectsBase::update_filters_activity() {
+  const auto suspended = is_suspended();
+
+  pm->lock();
+
+  for (auto& plugin : plugins | std::views::values) {
+    if (plugin->connected_to_pw) {
+      plugin->set_active(!suspended && !plugin->get_bypass());
+    }
+  }
+
+  pm->unlock();
+}
+
+void EffectsBase::on_filters_bypass_changed() {}
+
+void EffectsBase::on_plugin_bypass_changed(const std::string& name, const bool& state) {
+  const auto list = util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
+
+  const auto it = std::ranges::find(list, name);
+
+  if (it == list.end() || !plugins.contains(name) || !plugins[name]->connected_to_pw) {
+    return;
+  }
+
+  broadcast_pipeline_latency();
+
+  /*
+    Nothing is linked while the pipeline is unlinked by the inactivity timer, and nothing runs while it is suspended.
+    Only the plugin state is updated. The next connect_filters or resume_filters takes care of the links.
+  */
+
+  if (list_proxies.empty() || is_suspended()) {
+    if (state) {
+      pm->lock();
+
+      plugins[name]->set_active(false);
+
+      pm->sync_wait_unlock();
+    }
+
+    return;
+  }
+
+  // the echo canceller probe is linked to the output device by the subclasses
+
+  const auto source_id = get_chain_source_id();
+
+  if (source_id == SPA_ID_INVALID || name.starts_with(tags::plugin_name::echo_canceller)) {
+    relink_filters();
+
+    return;
+  }
+
+  auto is_linked = [&](const std::string& n) {
+    return plugins.contains(n) && plugins[n]->connected_to_pw && !plugins[n]->get_bypass();
+  };
+
+  uint prev_node_id = source_id;
+  uint next_node_id = get_chain_sink_id();
+
+  for (auto p = list.begin(); p != it; p++) {
+    if (is_linked(*p)) {
+      prev_node_id = plugins[*p]->get_node_id();
+    }
+  }
+
+  if (const auto n = std::ranges::find_if(std::next(it), list.end(), is_linked); n != list.end()) {
+    next_node_id = plugins[*n]->get_node_id();
+  }
+
+  const auto& plugin = plugins[name];
+
+  const auto node_id = plugin->get_node_id();
+
+  // The links being replaced. If one of them is missing the graph is not what we expect
+
+  std::vector<uint> old_link_ids;
+
+  auto find_links = [&](const uint& output_node_id, const uint& input_node_id) {
+    auto found = false;
+
+    for (const auto& link : pm->list_links) {
+      if (link.output_node_id == output_node_id && link.input_node_id == input_node_id) {
+        old_link_ids.push_back(link.id);
+
+        found = true;
+      }
+    }
+
+    return found;
+  };
+
+  const auto found = (state) ? find_links(prev_node_id, node_id) && find_links(node_id, next_node_id)
+                             : find_links(prev_node_id, next_node_id);
+
+  if (!found) {
+    relink_filters();
+
+    return;
+  }
+
+  auto link = [&](const uint& output_node_id, const uint& input_node_id) {
+    const auto links = pm->link_nodes(output_node_id, input_node_id);
+
+    list_proxies.insert(list_proxies.end(), links.begin(), links.end());
+  };
+
+  if (!state) {
+    pm->lock();
+
+    plugin->set_active(true);
+
+    pm->sync_wait_unlock();
+  }
+
+  for (const auto& id : old_link_ids) {
+    pm->destroy_object(static_cast<int>(id));
+  }
+
+  if (state) {
+    link(prev_node_id, next_node_id);
+  } else {
+    link(prev_node_id, node_id);
+    link(node_id, next_node_id);
+
+    plugin->update_probe_links();
+  }
+
+  if (state) {
+    pm->lock();
+
+    plugin->set_active(false);
+
+    pm->sync_wait_unlock();
+  }
+
+  update_shared_lookahead();
+
+  util::debug(log_tag + name + ((state) ? " bypassed and unlinked" : " linked again"));
+}
+
+void EffectsBase::update_shared_lookahead() {
+  const auto list = util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
+
+  const auto source_id = get_chain_source_id();
+
+  const auto enabled = g_settings_get_boolean(global_settings, "shared-lookahead") != 0 && source_id != SPA_ID_INVALID;
+
+  auto is_linked = [&](const std::string& name) {
+    const auto& plugin = plugins[name];
+
+    return std::ranges::find(list, name) != list.end() && plugin->connected_to_pw && !plugin->get_bypass();
+  };
+
+  for (const auto& [name, plugin] : plugins) {
+    if (!enabled || !is_linked(name)) {
+      plugin->set_shared_lookahead(0.0, SPA_ID_INVALID);
+    }
+  }
+
+  if (!enabled) {
+    return;
+  }
+
+  // The first plugin of a run delays the signal. The others read ahead from the node before it
+
+  std::vector<std::shared_ptr<PluginBase>> run;
+
+  uint prev_node_id = source_id;
+  uint run_source_id = SPA_ID_INVALID;
+
+  auto close_run = [&]() {
+    double budget = 0.0;
+
+    for (const auto& plugin : run) {
+      budget = std::max(budget, plugin->get_lookahead_ms());
+    }
+
+    for (size_t n = 0U; n < run.size(); n++) {
+      run[n]->set_shared_lookahead(budget, (n == 0U) ? SPA_ID_INVALID : run_source_id);
+    }
+
+    run.clear();
+  };
+
+  for (const auto& name : list) {
+    if (!plugins.contains(name) || !is_linked(name)) {
+      continue;
+    }
+
+    const auto& plugin = plugins[name];
+
+    const auto has_lookahead = plugin->get_lookahead_ms() > 0.0;
+
+    if (!has_lookahead || run.empty() || !plugin->can_read_ahead()) {
+      close_run();
+
+      if (has_lookahead) {
+        run_source_id = prev_node_id;
+      } else {
+        plugin->set_shared_lookahead(0.0, SPA_ID_INVALID);
+      }
+    }
+
+    if (has_lookahead) {
+      run.push_back(plugin);
+    }
+
+    prev_node_id = plugin->get_node_id();
+  }
+
+  close_run();
+}
@@ -34,6 +34,7 @@
 #include <sigc++/connection.h>
 #include <algorithm>
 #include <cstddef>
+#include <string>
 #include <vector>
 #include "application.hpp"
 #include "apps_box.hpp"
@@ -42,7 +43,9 @@
 #include "effects_base.hpp"
 #include "pipeline_type.hpp"
 #include "plugins_box.hpp"
+#include "stream_input_effects.hpp"
 #include "tags_app.hpp"
+#include "tags_plugin_name.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -84,7 +87,8 @@ struct _EffectsBox {
 
   AdwViewStackPage *apps_box_page, *plugins_box_page;
 
-  GtkLabel *device_state, *latency_status, *label_global_output_level_left, *label_global_output_level_right;
+  GtkLabel *device_state, *latency_status, *memory_status, *denoiser_status, *label_global_output_level_left,
+      *label_global_output_level_right;
 
   GtkToggleButton* toggle_listen_mic;
 
@@ -137,6 +141,20 @@ void init_spectrum_frequency_axis(EffectsBox* self) {
   }
 }
 
+void set_spectrum_y_data(EffectsBox* self) {
+  std::ranges::for_each(self->data->spectrum_mag, [](auto& v) {
+    v = 10.0F * std::log10(v);
+
+    if (!std::isinf(v)) {
+      v = (v > util::minimum_db_level) ? v : util::minimum_db_level;
+    } else {
+      v = util::minimum_db_level;
+    }
+  });
+
+  ui::chart::set_y_data(self->spectrum_chart, self->data->spectrum_mag);
+}
+
 void setup_spectrum(EffectsBox* self) {
   self->data->spectrum_rate = 0U;
   self->data->spectrum_n_bands = 0U;
@@ -321,6 +339,33 @@ void setup(EffectsBox* self, app::Application* application, PipelineType pipelin
         }
       }));
 
+      // the statistics of the denoiser comparison mode. They are emitted in the main thread
+
+      self->data->connections.push_back(application->sie->denoiser_stats.connect(
+          [=](const std::vector<StreamInputEffects::DenoiserStats>& stats) {
+            const auto& translated = tags::plugin_name::get_translated();
+
+            std::string text;
+
+            for (const auto& s : stats) {
+              const auto base_name = tags::plugin_name::get_base_name(s.name);
+
+              auto* name = g_markup_escape_text(
+                  (translated.contains(base_name) ? translated.at(base_name) : base_name).c_str(), -1);
+
+              const auto engine = fmt::format(ui::get_user_locale(), "{0} {1:.1Lf} % {2:.1Lf} ms", name,
+                                              100.0F * s.dsp_load, s.latency_ms);
+
+              g_free(name);
+
+              text += (text.empty() ? "" : "   ") + (s.monitored ? "<b>" + engine + "</b>" : engine);
+            }
+
+            gtk_label_set_markup(self->denoiser_status, text.c_str());
+
+            gtk_widget_set_visible(GTK_WIDGET(self->denoiser_status), stats.empty() ? 0 : 1);
+          }));
+
       break;
     }
     case PipelineType::output: {
@@ -395,8 +440,8 @@ void setup(EffectsBox* self, app::Application* application, PipelineType pipelin
 
   // spectrum array
 
-  self->data->connections.push_back(
-      self->data->effects_base->spectrum->power.connect([=](uint rate, uint n_bands, std::vector<double> magnitudes) {
+  self->data->connections.push_back(self->data->effects_base->spectrum->power.connect(
+      [=](uint rate, uint n_bands, const std::vector<double>& magnitudes) {
         if (self == nullptr) {
           return;
         }
@@ -429,22 +474,44 @@ void setup(EffectsBox* self, app::Application* application, PipelineType pipelin
         gsl_spline_free(spline);
         gsl_interp_accel_free(acc);
 
-        std::ranges::for_each(self->data->spectrum_mag, [](auto& v) {
-          v = 10.0F * std::log10(v);
+        set_spectrum_y_data(self);
+      }));
+
+  // In the logarithmic mode the bands are already computed at the chart points
+
+  self->data->connections.push_back(self->data->effects_base->spectrum->log_power.connect(
+      [=](const std::vector<double>& frequencies, const std::vector<double>& magnitudes) {
+        if (self == nullptr) {
+          return;
+        }
+
+        if (!ui::chart::get_is_visible(self->spectrum_chart)) {
+          return;
+        }
 
-          if (!std::isinf(v)) {
-            v = (v > util::minimum_db_level) ? v : util::minimum_db_level;
-          } else {
-            v = util::minimum_db_level;
-          }
-        });
+        if (!schedule_signal_idle) {
+          return;
+        }
 
-        ui::chart::set_y_data(self->spectrum_chart, self->data->spectrum_mag);
+        if (self->data->spectrum_x_axis != frequencies) {
+          self->data->spectrum_x_axis = frequencies;
+
+          ui::chart::set_x_data(self->spectrum_chart, self->data->spectrum_x_axis);
+
+          // forcing the linear mode to rebuild its axis if it is selected again
+
+          self->data->spectrum_rate = 0U;
+          self->data->spectrum_n_bands = 0U;
+        }
+
+        self->data->spectrum_mag = magnitudes;
+
+        set_spectrum_y_data(self);
       }));
 
   // As we are showing the window we want the filters to send notifications about level meters, etc
 
-  self->data->effects_base->spectrum->bypass = g_settings_get_boolean(self->settings_spectrum, "show") == 0;
+  self->data->effects_base->spectrum->set_bypass(g_settings_get_boolean(self->settings_spectrum, "show") == 0);
 
   self->data->effects_base->output_level->set_post_messages(true);
 
@@ -476,6 +543,12 @@ void setup(EffectsBox* self, app::Application* application, PipelineType pipelin
             },
         self);
   }));
+
+  // memory usage. It is computed periodically in the main thread
+
+  self->data->connections.push_back(self->data->effects_base->memory_usage.connect([=](const size_t& bytes) {
+    gtk_label_set_text(self->memory_status, util::format_bytes(bytes).c_str());
+  }));
 }
 
 void realize(GtkWidget* widget) {
@@ -495,7 +568,7 @@ void dispose(GObject* object) {
 
   schedule_signal_idle = false;
 
-  self->data->effects_base->spectrum->bypass = true;
+  self->data->effects_base->spectrum->set_bypass(true);
 
   for (auto& c : self->data->connections) {
     c.disconnect();
@@ -541,6 +614,8 @@ void effects_box_class_init(EffectsBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, EffectsBox, stack);
   gtk_widget_class_bind_template_child(widget_class, EffectsBox, device_state);
   gtk_widget_class_bind_template_child(widget_class, EffectsBox, latency_status);
+  gtk_widget_class_bind_template_child(widget_class, EffectsBox, denoiser_status);
+  gtk_widget_class_bind_template_child(widget_class, EffectsBox, memory_status);
   gtk_widget_class_bind_template_child(widget_class, EffectsBox, label_global_output_level_left);
   gtk_widget_class_bind_template_child(widget_class, EffectsBox, label_global_output_level_right);
   gtk_widget_class_bind_template_child(widget_class, EffectsBox, toggle_listen_mic);
@@ -574,12 +649,12 @@ void effects_box_init(EffectsBox* self) {
   gtk_box_insert_child_after(GTK_BOX(self), GTK_WIDGET(self->spectrum_chart), nullptr);
 
   g_signal_connect(GTK_WIDGET(self->spectrum_chart), "show", G_CALLBACK(+[](GtkWidget* widget, EffectsBox* self) {
-                     self->data->effects_base->spectrum->bypass = false;
+                     self->data->effects_base->spectrum->set_bypass(false);
                    }),
                    self);
 
   g_signal_connect(GTK_WIDGET(self->spectrum_chart), "hide", G_CALLBACK(+[](GtkWidget* widget, EffectsBox* self) {
-                     self->data->effects_base->spectrum->bypass = true;
+                     self->data->effects_base->spectrum->set_bypass(true);
                    }),
                    self);
 }
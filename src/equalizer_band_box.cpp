@@ -40,7 +40,7 @@ struct Data {
  public:
   ~Data() { util::debug("data struct destroyed"); }
 
-  int index = 0;  // index in the gsettings database
+  int index = -1;  // index in the gsettings database. -1 while the box is not bound
 };
 
 struct _EqualizerBandBox {
@@ -130,7 +130,29 @@ void setup(EqualizerBandBox* self, GSettings* settings) {
   self->settings = settings;
 }
 
+void unbind(EqualizerBandBox* self) {
+  g_settings_unbind(gtk_range_get_adjustment(GTK_RANGE(self->band_scale)), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->band_frequency), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->band_quality), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->band_width), "value");
+
+  g_settings_unbind(self->band_solo, "active");
+  g_settings_unbind(self->band_mute, "active");
+
+  g_settings_unbind(self->band_type, "selected");
+  g_settings_unbind(self->band_mode, "selected");
+  g_settings_unbind(self->band_slope, "selected");
+
+  self->data->index = -1;
+}
+
 void bind(EqualizerBandBox* self, int index) {
+  // recycled boxes may still be bound to the band they showed before
+
+  if (self->data->index != -1) {
+    unbind(self);
+  }
+
   self->data->index = index;
 
   gtk_label_set_text(self->band_number_label, util::to_string(index + 1).c_str());
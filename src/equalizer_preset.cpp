@@ -22,6 +22,7 @@
 #include <glib-object.h>
 #include <glib.h>
 #include <nlohmann/json_fwd.hpp>
+#include <string>
 #include "plugin_preset_base.hpp"
 #include "preset_type.hpp"
 #include "tags_equalizer.hpp"
@@ -63,6 +64,22 @@ EqualizerPreset::~EqualizerPreset() {
   g_object_unref(output_settings_right);
 }
 
+void EqualizerPreset::relocate(const std::string& base_path) {
+  PluginPresetBase::relocate(base_path);
+
+  auto*& settings_left = (preset_type == PresetType::input) ? input_settings_left : output_settings_left;
+  auto*& settings_right = (preset_type == PresetType::input) ? input_settings_right : output_settings_right;
+
+  auto* relocated_left = relocated_settings(settings_left, base_path);
+  auto* relocated_right = relocated_settings(settings_right, base_path);
+
+  g_object_unref(settings_left);
+  g_object_unref(settings_right);
+
+  settings_left = relocated_left;
+  settings_right = relocated_right;
+}
+
 void EqualizerPreset::save(nlohmann::json& json) {
   json[section][instance_name]["bypass"] = g_settings_get_boolean(settings, "bypass") != 0;
 
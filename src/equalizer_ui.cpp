@@ -923,21 +923,40 @@ auto sort_band_widgets(EqualizerBox* self, const int nbands, GSettings* settings
   return output;
 }
 
+void update_band_list(GtkStringList* string_list, const std::vector<std::string>& list) {
+  /*
+    Only the rows after the first difference are replaced. The list view rebinds just the rows that changed, so a
+    preset that keeps the number of bands does not rebuild the visible band boxes.
+  */
+
+  const auto n_items = g_list_model_get_n_items(G_LIST_MODEL(string_list));
+
+  guint first_change = 0U;
+
+  while (first_change < n_items && first_change < list.size() &&
+         list[first_change] == gtk_string_list_get_string(string_list, first_change)) {
+    first_change++;
+  }
+
+  if (first_change == n_items && first_change == list.size()) {
+    return;
+  }
+
+  const std::vector<std::string> changed(list.begin() + first_change, list.end());
+
+  gtk_string_list_splice(string_list, first_change, n_items - first_change,
+                         util::make_gchar_pointer_vector(changed).data());
+}
+
 void build_all_bands(EqualizerBox* self, const bool& sort_by_freq = false) {
   const auto split = g_settings_get_boolean(self->settings, "split-channels") != 0;
 
   const auto nbands = g_settings_get_int(self->settings, "num-bands");
 
-  auto list = sort_band_widgets(self, nbands, self->settings_left, sort_by_freq);
-
-  gtk_string_list_splice(self->string_list_left, 0, g_list_model_get_n_items(G_LIST_MODEL(self->string_list_left)),
-                         util::make_gchar_pointer_vector(list).data());
+  update_band_list(self->string_list_left, sort_band_widgets(self, nbands, self->settings_left, sort_by_freq));
 
   if (split) {
-    list = sort_band_widgets(self, nbands, self->settings_right, sort_by_freq);
-
-    gtk_string_list_splice(self->string_list_right, 0, g_list_model_get_n_items(G_LIST_MODEL(self->string_list_right)),
-                           util::make_gchar_pointer_vector(list).data());
+    update_band_list(self->string_list_right, sort_band_widgets(self, nbands, self->settings_right, sort_by_freq));
   }
 }
 
@@ -984,6 +1003,15 @@ void setup_listview(EqualizerBox* self) {
       }),
       self);
 
+  g_signal_connect(factory, "unbind",
+                   G_CALLBACK(+[](GtkSignalListItemFactory* factory, GtkListItem* item, EqualizerBox* self) {
+                     auto* band_box = static_cast<ui::equalizer_band_box::EqualizerBandBox*>(
+                         g_object_get_data(G_OBJECT(item), "band-box"));
+
+                     ui::equalizer_band_box::unbind(band_box);
+                   }),
+                   self);
+
   if constexpr (channel == Channel::left) {
     gtk_list_view_set_factory(self->listview_left, factory);
   } else if constexpr (channel == Channel::right) {
@@ -219,3 +219,7 @@ void FirFilterBase::direct_conv(const std::vector<float>& a, const std::vector<f
 auto FirFilterBase::get_delay() const -> float {
   return delay;
 }
+
+auto FirFilterBase::get_memory_usage() const -> size_t {
+  return util::container_bytes(kernel) + (zita_ready ? util::zita_memory_usage(2U, kernel.size(), n_samples) : 0U);
+}
@@ -73,8 +73,9 @@ auto LevelMeter::init_ebur128() -> bool {
     ebur_state = nullptr;
   }
 
-  ebur_state = ebur128_init(
-      2U, rate, EBUR128_MODE_S | EBUR128_MODE_I | EBUR128_MODE_LRA | EBUR128_MODE_TRUE_PEAK | EBUR128_MODE_HISTOGRAM);
+  // The true peak is measured by our own detector. The libebur128 oversampler is much more expensive
+
+  ebur_state = ebur128_init(2U, rate, EBUR128_MODE_S | EBUR128_MODE_I | EBUR128_MODE_LRA | EBUR128_MODE_HISTOGRAM);
 
   ebur128_set_channel(ebur_state, 0U, EBUR128_LEFT);
   ebur128_set_channel(ebur_state, 1U, EBUR128_RIGHT);
@@ -87,6 +88,12 @@ void LevelMeter::setup() {
     data.resize(static_cast<size_t>(n_samples) * 2U);
   }
 
+  data_mutex.lock();
+
+  true_peak.setup(rate, n_samples);
+
+  data_mutex.unlock();
+
   if (rate != old_rate) {
     data_mutex.lock();
 
@@ -154,13 +161,10 @@ void LevelMeter::process(std::span<float>& left_in,
     range = 0.0;
   }
 
-  if (EBUR128_SUCCESS != ebur128_true_peak(ebur_state, 0U, &true_peak_L)) {
-    true_peak_L = 0.0;
-  }
+  true_peak.process(left_in, right_in);
 
-  if (EBUR128_SUCCESS != ebur128_true_peak(ebur_state, 1U, &true_peak_R)) {
-    true_peak_R = 0.0;
-  }
+  true_peak_L = true_peak.get_true_peak_left();
+  true_peak_R = true_peak.get_true_peak_right();
 
   if (post_messages) {
     get_peaks(left_in, right_in, left_out, right_out);
@@ -168,6 +172,12 @@ void LevelMeter::process(std::span<float>& left_in,
     if (send_notifications) {
       results.emit(momentary, shortterm, global, relative, range, true_peak_L, true_peak_R);
 
+      meter_values = {static_cast<float>(momentary), static_cast<float>(shortterm),   static_cast<float>(global),
+                      static_cast<float>(relative),  static_cast<float>(range),       static_cast<float>(true_peak_L),
+                      static_cast<float>(true_peak_R)};
+
+      n_meter_values = 7U;
+
       notify();
     }
   }
@@ -177,12 +187,18 @@ auto LevelMeter::get_latency_seconds() -> float {
   return 0.0F;
 }
 
+auto LevelMeter::count_memory_usage() -> size_t {
+  return PluginBase::count_memory_usage() + util::container_bytes(data) + true_peak.get_memory_usage();
+}
+
 void LevelMeter::reset_history() {
   mythreads.emplace_back([this]() {  // Using emplace_back here makes sense
     data_mutex.lock();
 
     ebur128_ready = false;
 
+    true_peak.reset();
+
     data_mutex.unlock();
 
     auto status = init_ebur128();
@@ -28,7 +28,6 @@
 #include <string>
 #include "lv2_wrapper.hpp"
 #include "pipe_manager.hpp"
-#include "pipe_objects.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
@@ -100,7 +99,20 @@ Limiter::Limiter(const std::string& tag,
 
   lv2_wrapper->bind_key_bool<"extsc", "external-sidechain">(settings);
 
+  /*
+    The limiter needs its own lookahead whatever its sidechain is, so it never reads ahead. It can only be the plugin
+    that delays the signal for the others. It overrides the port bound above.
+  */
+
+  setup_shared_lookahead({.lookahead_key = "lookahead", .lookahead_port = "lk"});
+
   setup_input_output_gain();
+
+  if (package_installed) {
+    latency_port_index = lv2_wrapper->get_control_port_index("out_latency");
+
+    meter_ports = lv2_wrapper->get_control_port_indices(meter_port_symbols);
+  }
 }
 
 Limiter::~Limiter() {
@@ -151,7 +163,7 @@ void Limiter::process(std::span<float>& left_in,
    This plugin gives the latency in number of samples
  */
 
-  const auto lv = static_cast<uint>(lv2_wrapper->get_control_port_value("out_latency"));
+  const auto lv = static_cast<uint>(lv2_wrapper->get_control_port_value(latency_port_index));
 
   if (latency_n_frames != lv) {
     latency_n_frames = lv;
@@ -175,10 +187,12 @@ void Limiter::process(std::span<float>& left_in,
     get_peaks(left_in, right_in, left_out, right_out);
 
     if (send_notifications) {
-      gain_l_port_value = lv2_wrapper->get_control_port_value("grlm_l");
-      gain_r_port_value = lv2_wrapper->get_control_port_value("grlm_r");
-      sidechain_l_port_value = lv2_wrapper->get_control_port_value("sclm_l");
-      sidechain_r_port_value = lv2_wrapper->get_control_port_value("sclm_r");
+      lv2_wrapper->get_control_port_values(meter_ports, meter_port_values);
+
+      gain_l_port_value = meter_port_values[0];
+      gain_r_port_value = meter_port_values[1];
+      sidechain_l_port_value = meter_port_values[2];
+      sidechain_r_port_value = meter_port_values[3];
 
       gain_left.emit(gain_l_port_value);
       gain_right.emit(gain_r_port_value);
@@ -201,23 +215,9 @@ void Limiter::update_sidechain_links(const std::string& key) {
 
   const auto device_name = util::gsettings_get_string(settings, "sidechain-input-device");
 
-  NodeInfo input_device = pm->ee_source_node;
-
-  for (const auto& [serial, node] : pm->node_map) {
-    if (node.name == device_name) {
-      input_device = node;
-
-      break;
-    }
-  }
-
   pm->destroy_links(list_proxies);
 
-  list_proxies.clear();
-
-  for (const auto& link : pm->link_nodes(input_device.id, get_node_id(), true)) {
-    list_proxies.push_back(link);
-  }
+  list_proxies = pm->link_sidechain(device_name, get_node_id());
 }
 
 void Limiter::update_probe_links() {
@@ -227,3 +227,4 @@ void Limiter::update_probe_links() {
 auto Limiter::get_latency_seconds() -> float {
   return this->latency_value;
 }
+
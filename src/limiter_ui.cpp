@@ -146,7 +146,8 @@ void setup(LimiterBox* self, std::shared_ptr<Limiter> limiter, const std::string
 
     if (node.media_class == tags::pipewire::media_class::source ||
         node.media_class == tags::pipewire::media_class::virtual_source ||
-        node.media_role == tags::pipewire::media_role::dsp) {
+        node.media_role == tags::pipewire::media_role::dsp ||
+        node.media_class == tags::pipewire::media_class::output_stream) {
       auto* holder = ui::holders::create(node);
 
       g_list_store_append(self->input_devices_model, holder);
@@ -155,6 +156,8 @@ void setup(LimiterBox* self, std::shared_ptr<Limiter> limiter, const std::string
     }
   }
 
+  ui::setup_sidechain_sources(self->input_devices_model, pm, self->data->connections);
+
   self->data->connections.push_back(limiter->input_level.connect([=](const float left, const float right) {
     g_object_ref(self);
 
@@ -31,13 +31,16 @@
 #include <lv2/ui/ui.h>
 #include <lv2/urid/urid.h>
 #include <sys/types.h>
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <cmath>
 #include <cstdarg>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <functional>
+#include <future>
 #include <mutex>
 #include <span>
 #include <string>
@@ -62,7 +65,61 @@ auto lv2_printf(LV2_Log_Handle handle, LV2_URID type, const char* format, ...) -
   return r;
 }
 
-Lv2Wrapper::Lv2Wrapper(const std::string& plugin_uri) : plugin_uri(plugin_uri), world(lilv_world_new()) {
+namespace {
+
+std::mutex world_mutex;
+
+std::shared_future<LilvWorld*> world_future;
+
+}  // namespace
+
+void preload_world() {
+  std::scoped_lock<std::mutex> lock(world_mutex);
+
+  if (world_future.valid()) {
+    return;
+  }
+
+  world_future = std::async(std::launch::async, []() {
+                   auto* world = lilv_world_new();
+
+                   if (world != nullptr) {
+                     lilv_world_load_all(world);
+                   }
+
+                   return world;
+                 }).share();
+}
+
+auto get_world() -> LilvWorld* {
+  preload_world();
+
+  std::shared_future<LilvWorld*> future;
+
+  {
+    std::scoped_lock<std::mutex> lock(world_mutex);
+
+    future = world_future;
+  }
+
+  return future.get();
+}
+
+void free_world() {
+  std::scoped_lock<std::mutex> lock(world_mutex);
+
+  if (!world_future.valid()) {
+    return;
+  }
+
+  if (auto* world = world_future.get(); world != nullptr) {
+    lilv_world_free(world);
+  }
+
+  world_future = std::shared_future<LilvWorld*>();
+}
+
+Lv2Wrapper::Lv2Wrapper(const std::string& plugin_uri) : plugin_uri(plugin_uri), world(get_world()) {
   if (world == nullptr) {
     util::warning("failed to initialized the world");
 
@@ -77,8 +134,6 @@ Lv2Wrapper::Lv2Wrapper(const std::string& plugin_uri) : plugin_uri(plugin_uri),
     return;
   }
 
-  lilv_world_load_all(world);
-
   const LilvPlugins* plugins = lilv_world_get_all_plugins(world);
 
   plugin = lilv_plugins_get_by_uri(plugins, uri);
@@ -105,10 +160,6 @@ Lv2Wrapper::~Lv2Wrapper() {
 
     instance = nullptr;
   }
-
-  if (world != nullptr) {
-    lilv_world_free(world);
-  }
 }
 
 void Lv2Wrapper::check_required_features() {
@@ -431,6 +482,30 @@ auto Lv2Wrapper::get_control_port_value(const std::string& symbol) -> float {
   return 0.0F;
 }
 
+auto Lv2Wrapper::get_control_port_index(const std::string& symbol) -> uint {
+  for (const auto& p : ports) {
+    if (p.type == PortType::TYPE_CONTROL && p.symbol == symbol) {
+      return p.index;
+    }
+  }
+
+  util::warning(plugin_uri + " port symbol not found: " + symbol);
+
+  return invalid_port_index;
+}
+
+auto Lv2Wrapper::get_control_port_value(const uint& index) const -> float {
+  return (index < ports.size()) ? ports[index].value : 0.0F;
+}
+
+void Lv2Wrapper::get_control_port_values(std::span<const uint> indices, std::span<float> values) const {
+  const auto count = std::min(indices.size(), values.size());
+
+  for (size_t n = 0U; n < count; n++) {
+    values[n] = get_control_port_value(indices[n]);
+  }
+}
+
 auto Lv2Wrapper::has_instance() -> bool {
   return instance != nullptr;
 }
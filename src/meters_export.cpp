@@ -0,0 +1,307 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "meters_export.hpp"
+#include <fcntl.h>
+#include <gio/gio.h>
+#include <glib-object.h>
+#include <glib.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+#include "pipeline_type.hpp"
+#include "tags_app.hpp"
+#include "util.hpp"
+
+namespace {
+
+auto monotonic_ns() -> uint64_t {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+template <typename T>
+void seqlock_write_begin(T& obj) {
+  obj.sequence.store(obj.sequence.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+template <typename T>
+void seqlock_write_end(T& obj) {
+  obj.sequence.store(obj.sequence.load(std::memory_order_relaxed) + 1U, std::memory_order_release);
+}
+
+auto pipeline_index(const PipelineType& pipeline) -> uint32_t {
+  return (pipeline == PipelineType::output) ? 0U : 1U;
+}
+
+}  // namespace
+
+MetersExport::MetersExport() : settings(g_settings_new(tags::app::id)) {
+  if (g_settings_get_boolean(settings, "export-meters") != 0) {
+    enable();
+  }
+
+  gconnections.push_back(g_signal_connect(settings, "changed::export-meters",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                            auto* self = static_cast<MetersExport*>(user_data);
+
+                                            if (g_settings_get_boolean(settings, key) != 0) {
+                                              self->enable();
+                                            } else {
+                                              self->disable();
+                                            }
+                                          }),
+                                          this));
+}
+
+MetersExport::~MetersExport() {
+  for (auto& handler_id : gconnections) {
+    g_signal_handler_disconnect(settings, handler_id);
+  }
+
+  gconnections.clear();
+
+  disable();
+
+  if (layout != nullptr) {
+    munmap(layout, sizeof(meters_export::Layout));
+  }
+
+  if (fd != -1) {
+    close(fd);
+  }
+
+  g_object_unref(settings);
+
+  util::debug("destroyed");
+}
+
+auto MetersExport::info_file_path() -> std::string {
+  return std::string(g_get_user_runtime_dir()) + "/easyeffects/meters";
+}
+
+auto MetersExport::is_enabled() const -> bool {
+  return enabled.load(std::memory_order_acquire);
+}
+
+void MetersExport::enable() {
+  if (enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  /*
+    The region is never unmapped while we are running. The realtime threads may be in the middle of a write when the
+    export is disabled, so disabling just stops the publication.
+  */
+
+  if (layout == nullptr) {
+    fd = memfd_create("easyeffects-meters", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+
+    if (fd == -1) {
+      util::warning("could not create the memfd used to export the level meters");
+
+      return;
+    }
+
+    if (ftruncate(fd, sizeof(meters_export::Layout)) != 0) {
+      util::warning("could not set the size of the level meters shared memory");
+
+      close(fd);
+
+      fd = -1;
+
+      return;
+    }
+
+    fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL);
+
+    auto* ptr = mmap(nullptr, sizeof(meters_export::Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (ptr == MAP_FAILED) {
+      util::warning("could not map the level meters shared memory");
+
+      close(fd);
+
+      fd = -1;
+
+      return;
+    }
+
+    // ftruncate filled the region with zeros. That is a valid initial state for all the sequence counters.
+
+    layout = static_cast<meters_export::Layout*>(ptr);
+
+    layout->magic = meters_export::magic;
+    layout->version = meters_export::version;
+    layout->n_slots = meters_export::max_slots;
+    layout->n_spectrum = layout->spectrum.size();
+  }
+
+  for (int n = 0; n < static_cast<int>(slots_info.size()); n++) {
+    write_slot_header(n);
+  }
+
+  const auto info_path = std::filesystem::path(info_file_path());
+
+  try {
+    std::filesystem::create_directories(info_path.parent_path());
+
+    std::ofstream ofs{info_path};
+
+    ofs << "/proc/" << getpid() << "/fd/" << fd << '\n';
+  } catch (const std::exception& e) {
+    util::warning(e.what());
+  }
+
+  enabled.store(true, std::memory_order_release);
+
+  util::debug("level meters are exported to shared memory. See " + info_path.string());
+}
+
+void MetersExport::disable() {
+  if (!enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  enabled.store(false, std::memory_order_release);
+
+  std::error_code ec;
+
+  std::filesystem::remove(info_file_path(), ec);
+
+  util::debug("level meters export disabled");
+}
+
+auto MetersExport::acquire_slot(const PipelineType& pipeline, const std::string& label) -> int {
+  for (int n = 0; n < static_cast<int>(slots_info.size()); n++) {
+    if (slots_info[n].in_use) {
+      continue;
+    }
+
+    slots_info[n].in_use = true;
+    slots_info[n].pipeline = pipeline;
+    slots_info[n].label = label;
+
+    write_slot_header(n);
+
+    return n;
+  }
+
+  util::warning("no free level meter slot for " + label);
+
+  return -1;
+}
+
+void MetersExport::release_slot(const int& index) {
+  if (index < 0 || index >= static_cast<int>(slots_info.size())) {
+    return;
+  }
+
+  slots_info[index] = SlotInfo();
+
+  write_slot_header(index);
+}
+
+void MetersExport::write_slot_header(const int& index) {
+  if (layout == nullptr) {
+    return;
+  }
+
+  const auto& info = slots_info[index];
+
+  auto& slot = layout->slots[index];
+
+  seqlock_write_begin(slot);
+
+  slot.in_use = info.in_use ? 1U : 0U;
+  slot.pipeline = pipeline_index(info.pipeline);
+  slot.n_values = 0U;
+  slot.timestamp = monotonic_ns();
+
+  slot.label.fill('\0');
+
+  std::copy_n(info.label.begin(), std::min(info.label.size(), slot.label.size() - 1U), slot.label.begin());
+
+  slot.input_level.fill(util::minimum_db_level);
+  slot.output_level.fill(util::minimum_db_level);
+  slot.values.fill(0.0F);
+
+  seqlock_write_end(slot);
+}
+
+void MetersExport::publish_levels(const int& index,
+                                  const float& input_left,
+                                  const float& input_right,
+                                  const float& output_left,
+                                  const float& output_right,
+                                  std::span<const float> values) {
+  if (index < 0 || !enabled.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  auto& slot = layout->slots[index];
+
+  const auto n_values = std::min(values.size(), slot.values.size());
+
+  seqlock_write_begin(slot);
+
+  slot.timestamp = monotonic_ns();
+  slot.input_level = {input_left, input_right};
+  slot.output_level = {output_left, output_right};
+  slot.n_values = static_cast<uint32_t>(n_values);
+
+  std::copy_n(values.begin(), n_values, slot.values.begin());
+
+  seqlock_write_end(slot);
+}
+
+void MetersExport::publish_spectrum(const PipelineType& pipeline,
+                                    const uint& rate,
+                                    const std::vector<double>& magnitudes) {
+  if (!enabled.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  auto& spectrum = layout->spectrum[pipeline_index(pipeline)];
+
+  const auto n_bins = std::min(magnitudes.size(), spectrum.bins.size());
+
+  seqlock_write_begin(spectrum);
+
+  spectrum.timestamp = monotonic_ns();
+  spectrum.rate = rate;
+  spectrum.n_bins = static_cast<uint32_t>(n_bins);
+
+  std::transform(magnitudes.begin(), magnitudes.begin() + static_cast<long>(n_bins), spectrum.bins.begin(),
+                 [](const double& v) { return static_cast<float>(v); });
+
+  seqlock_write_end(spectrum);
+}
@@ -23,13 +23,13 @@
 #include <glib.h>
 #include <sys/types.h>
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <span>
 #include <string>
 #include <utility>
 #include "lv2_wrapper.hpp"
 #include "pipe_manager.hpp"
-#include "pipe_objects.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
@@ -77,6 +77,8 @@ MultibandCompressor::MultibandCompressor(const std::string& tag,
   bind_bands(std::make_index_sequence<n_bands>());
 
   setup_input_output_gain();
+
+  resolve_meter_ports();
 }
 
 MultibandCompressor::~MultibandCompressor() {
@@ -127,7 +129,7 @@ void MultibandCompressor::process(std::span<float>& left_in,
    This plugin gives the latency in number of samples
  */
 
-  const auto lv = static_cast<uint>(lv2_wrapper->get_control_port_value("out_latency"));
+  const auto lv = static_cast<uint>(lv2_wrapper->get_control_port_value(latency_port_index));
 
   if (latency_n_frames != lv) {
     latency_n_frames = lv;
@@ -151,25 +153,18 @@ void MultibandCompressor::process(std::span<float>& left_in,
     get_peaks(left_in, right_in, left_out, right_out);
 
     if (send_notifications) {
-      for (uint n = 0U; n < n_bands; n++) {
-        const auto nstr = util::to_string(n);
-
-        frequency_range_end_port_array.at(n) = lv2_wrapper->get_control_port_value("fre_" + nstr);
-
-        envelope_port_array.at(n) = 0.5F * (lv2_wrapper->get_control_port_value("elm_" + nstr + "l") +
-                                            lv2_wrapper->get_control_port_value("elm_" + nstr + "r"));
+      lv2_wrapper->get_control_port_values(band_meter_ports, band_meter_port_values);
 
-        curve_port_array.at(n) = 0.5F * (lv2_wrapper->get_control_port_value("clm_" + nstr + "l") +
-                                         lv2_wrapper->get_control_port_value("clm_" + nstr + "r"));
+      for (uint n = 0U; n < n_bands; n++) {
+        const auto values = std::span(band_meter_port_values).subspan(n * n_band_meter_ports, n_band_meter_ports);
 
-        reduction_port_array.at(n) = 0.5F * (lv2_wrapper->get_control_port_value("rlm_" + nstr + "l") +
-                                             lv2_wrapper->get_control_port_value("rlm_" + nstr + "r"));
+        band_meters_values.frequency_range_end[n] = values[0];
+        band_meters_values.envelope[n] = 0.5F * (values[1] + values[2]);
+        band_meters_values.curve[n] = 0.5F * (values[3] + values[4]);
+        band_meters_values.reduction[n] = 0.5F * (values[5] + values[6]);
       }
 
-      frequency_range.emit(frequency_range_end_port_array);
-      envelope.emit(envelope_port_array);
-      curve.emit(curve_port_array);
-      reduction.emit(reduction_port_array);
+      band_meters.emit(band_meters_values);
 
       notify();
     }
@@ -195,22 +190,30 @@ void MultibandCompressor::update_sidechain_links(const std::string& key) {
 
   const auto device_name = util::gsettings_get_string(settings, "sidechain-input-device");
 
-  NodeInfo input_device = pm->ee_source_node;
+  pm->destroy_links(list_proxies);
 
-  for (const auto& [serial, node] : pm->node_map) {
-    if (node.name == device_name) {
-      input_device = node;
+  list_proxies = pm->link_sidechain(device_name, get_node_id());
+}
 
-      break;
-    }
+void MultibandCompressor::resolve_meter_ports() {
+  band_meter_ports.fill(lv2::Lv2Wrapper::invalid_port_index);
+
+  if (!package_installed) {
+    return;
   }
 
-  pm->destroy_links(list_proxies);
+  latency_port_index = lv2_wrapper->get_control_port_index("out_latency");
 
-  list_proxies.clear();
+  for (uint n = 0U; n < n_bands; n++) {
+    const auto nstr = util::to_string(n);
+
+    const std::array<std::string, n_band_meter_ports> symbols = {
+        "fre_" + nstr,       "elm_" + nstr + "l", "elm_" + nstr + "r", "clm_" + nstr + "l",
+        "clm_" + nstr + "r", "rlm_" + nstr + "l", "rlm_" + nstr + "r"};
 
-  for (const auto& link : pm->link_nodes(input_device.id, get_node_id(), true)) {
-    list_proxies.push_back(link);
+    for (uint m = 0U; m < n_band_meter_ports; m++) {
+      band_meter_ports.at((n * n_band_meter_ports) + m) = lv2_wrapper->get_control_port_index(symbols.at(m));
+    }
   }
 }
 
@@ -38,7 +38,7 @@ struct Data {
  public:
   ~Data() { util::debug("data struct destroyed"); }
 
-  int index;
+  int index = -1;  // -1 while the box is not bound to a band
 
   std::vector<gulong> gconnections;
 };
@@ -60,6 +60,8 @@ struct _MultibandCompressorBandBox {
 
   GtkBox* split_frequency_box;
 
+  GtkLabel* split_frequency_zero;
+
   GSettings* settings;
 
   Data* data;
@@ -142,28 +144,73 @@ void set_gain_label(MultibandCompressorBandBox* self, const float& value) {
   gtk_label_set_text(self->gain_label, fmt::format("{0:.0f}", util::linear_to_db(value)).c_str());
 }
 
-void setup(MultibandCompressorBandBox* self, GSettings* settings, int index) {
-  self->data->index = index;
+void setup(MultibandCompressorBandBox* self, GSettings* settings) {
   self->settings = settings;
 
-  using namespace tags::multiband_compressor;
+  // bind source dropdowns sensitive property to split-stereo gsettings boolean
 
-  if (index > 0) {
-    g_settings_bind(settings, band_split_frequency[index].data(), gtk_spin_button_get_adjustment(self->split_frequency),
-                    "value", G_SETTINGS_BIND_DEFAULT);
-  } else {
-    // removing split frequency from band 0
+  g_settings_bind(self->settings, "stereo-split", self->sidechain_source, "sensitive",
+                  static_cast<GSettingsBindFlags>(G_SETTINGS_BIND_DEFAULT | G_SETTINGS_BIND_INVERT_BOOLEAN));
 
-    for (auto* child = gtk_widget_get_last_child(GTK_WIDGET(self->split_frequency_box)); child != nullptr;
-         child = gtk_widget_get_last_child(GTK_WIDGET(self->split_frequency_box))) {
-      gtk_box_remove(self->split_frequency_box, child);
-    }
+  g_settings_bind(self->settings, "stereo-split", self->stereo_split_source, "sensitive", G_SETTINGS_BIND_DEFAULT);
+}
+
+void unbind(MultibandCompressorBandBox* self) {
+  if (self->data->index > 0) {
+    g_settings_unbind(gtk_spin_button_get_adjustment(self->split_frequency), "value");
+  }
 
-    auto* label = gtk_label_new("0 Hz");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->lowcut_filter_frequency), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->highcut_filter_frequency), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->attack_time), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->attack_threshold), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->release_time), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->release_threshold), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->ratio), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->knee), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->makeup), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->sidechain_preamp), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->sidechain_reactivity), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->sidechain_lookahead), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->boost_amount), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->boost_threshold), "value");
+
+  g_settings_unbind(self->bypass, "active");
+  g_settings_unbind(self->mute, "active");
+  g_settings_unbind(self->solo, "active");
+  g_settings_unbind(self->lowcut_filter, "active");
+  g_settings_unbind(self->highcut_filter, "active");
+  g_settings_unbind(self->external_sidechain, "active");
+
+  g_settings_unbind(self->compression_mode, "selected");
+  g_settings_unbind(self->sidechain_mode, "selected");
+  g_settings_unbind(self->sidechain_source, "selected");
+  g_settings_unbind(self->stereo_split_source, "selected");
+
+  self->data->index = -1;
+}
 
-    gtk_widget_set_halign(GTK_WIDGET(label), GTK_ALIGN_CENTER);
+void bind(MultibandCompressorBandBox* self, int index) {
+  // the box is recycled when another band is selected
 
-    gtk_box_append(self->split_frequency_box, GTK_WIDGET(label));
+  if (self->data->index != -1) {
+    unbind(self);
+  }
+
+  self->data->index = index;
+
+  using namespace tags::multiband_compressor;
+
+  auto* settings = self->settings;
+
+  // band 0 has no split frequency
+
+  gtk_widget_set_visible(GTK_WIDGET(self->split_frequency), index > 0 ? 1 : 0);
+  gtk_widget_set_visible(GTK_WIDGET(self->split_frequency_zero), index > 0 ? 0 : 1);
+
+  if (index > 0) {
+    g_settings_bind(settings, band_split_frequency[index].data(), gtk_spin_button_get_adjustment(self->split_frequency),
+                    "value", G_SETTINGS_BIND_DEFAULT);
   }
 
   ui::gsettings_bind_enum_to_combo_widget(self->settings, band_compression_mode[index].data(), self->compression_mode);
@@ -232,13 +279,6 @@ void setup(MultibandCompressorBandBox* self, GSettings* settings, int index) {
 
   g_settings_bind(settings, band_boost_threshold[index].data(), gtk_spin_button_get_adjustment(self->boost_threshold),
                   "value", G_SETTINGS_BIND_DEFAULT);
-
-  // bind source dropdowns sensitive property to split-stereo gsettings boolean
-
-  g_settings_bind(self->settings, "stereo-split", self->sidechain_source, "sensitive",
-                  static_cast<GSettingsBindFlags>(G_SETTINGS_BIND_DEFAULT | G_SETTINGS_BIND_INVERT_BOOLEAN));
-
-  g_settings_bind(self->settings, "stereo-split", self->stereo_split_source, "sensitive", G_SETTINGS_BIND_DEFAULT);
 }
 
 void dispose(GObject* object) {
@@ -284,6 +324,7 @@ void multiband_compressor_band_box_class_init(MultibandCompressorBandBoxClass* k
   gtk_widget_class_bind_template_child(widget_class, MultibandCompressorBandBox, curve_label);
   gtk_widget_class_bind_template_child(widget_class, MultibandCompressorBandBox, split_frequency);
   gtk_widget_class_bind_template_child(widget_class, MultibandCompressorBandBox, split_frequency_box);
+  gtk_widget_class_bind_template_child(widget_class, MultibandCompressorBandBox, split_frequency_zero);
   gtk_widget_class_bind_template_child(widget_class, MultibandCompressorBandBox, lowcut_filter);
   gtk_widget_class_bind_template_child(widget_class, MultibandCompressorBandBox, highcut_filter);
   gtk_widget_class_bind_template_child(widget_class, MultibandCompressorBandBox, lowcut_filter_frequency);
@@ -38,7 +38,7 @@ struct Data {
  public:
   ~Data() { util::debug("data struct destroyed"); }
 
-  int index;
+  int index = -1;  // -1 while the box is not bound to a band
 
   std::vector<gulong> gconnections;
 };
@@ -60,6 +60,8 @@ struct _MultibandGateBandBox {
 
   GtkBox* split_frequency_box;
 
+  GtkLabel* split_frequency_zero;
+
   GSettings* settings;
 
   Data* data;
@@ -116,28 +118,72 @@ void set_gain_label(MultibandGateBandBox* self, const float& value) {
   gtk_label_set_text(self->gain_label, fmt::format("{0:.0f}", util::linear_to_db(value)).c_str());
 }
 
-void setup(MultibandGateBandBox* self, GSettings* settings, int index) {
-  self->data->index = index;
+void setup(MultibandGateBandBox* self, GSettings* settings) {
   self->settings = settings;
 
-  using namespace tags::multiband_gate;
+  // bind source dropdowns sensitive property to split-stereo gsettings boolean
 
-  if (index > 0) {
-    g_settings_bind(settings, band_split_frequency[index].data(), gtk_spin_button_get_adjustment(self->split_frequency),
-                    "value", G_SETTINGS_BIND_DEFAULT);
-  } else {
-    // removing split frequency from band 0
+  g_settings_bind(self->settings, "stereo-split", self->sidechain_source, "sensitive",
+                  static_cast<GSettingsBindFlags>(G_SETTINGS_BIND_DEFAULT | G_SETTINGS_BIND_INVERT_BOOLEAN));
 
-    for (auto* child = gtk_widget_get_last_child(GTK_WIDGET(self->split_frequency_box)); child != nullptr;
-         child = gtk_widget_get_last_child(GTK_WIDGET(self->split_frequency_box))) {
-      gtk_box_remove(self->split_frequency_box, child);
-    }
+  g_settings_bind(self->settings, "stereo-split", self->stereo_split_source, "sensitive", G_SETTINGS_BIND_DEFAULT);
+}
+
+void unbind(MultibandGateBandBox* self) {
+  if (self->data->index > 0) {
+    g_settings_unbind(gtk_spin_button_get_adjustment(self->split_frequency), "value");
+  }
 
-    auto* label = gtk_label_new("0 Hz");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->lowcut_filter_frequency), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->highcut_filter_frequency), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->attack_time), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->release_time), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->hysteresis_threshold), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->hysteresis_zone), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->curve_threshold), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->curve_zone), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->reduction), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->makeup), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->sidechain_preamp), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->sidechain_reactivity), "value");
+  g_settings_unbind(gtk_spin_button_get_adjustment(self->sidechain_lookahead), "value");
+
+  g_settings_unbind(self->bypass, "active");
+  g_settings_unbind(self->mute, "active");
+  g_settings_unbind(self->solo, "active");
+  g_settings_unbind(self->lowcut_filter, "active");
+  g_settings_unbind(self->highcut_filter, "active");
+  g_settings_unbind(self->external_sidechain, "active");
+  g_settings_unbind(self->hysteresis, "active");
+
+  g_settings_unbind(self->sidechain_mode, "selected");
+  g_settings_unbind(self->sidechain_source, "selected");
+  g_settings_unbind(self->stereo_split_source, "selected");
+
+  self->data->index = -1;
+}
 
-    gtk_widget_set_halign(GTK_WIDGET(label), GTK_ALIGN_CENTER);
+void bind(MultibandGateBandBox* self, int index) {
+  // the box is recycled when another band is selected
 
-    gtk_box_append(self->split_frequency_box, GTK_WIDGET(label));
+  if (self->data->index != -1) {
+    unbind(self);
+  }
+
+  self->data->index = index;
+
+  using namespace tags::multiband_gate;
+
+  auto* settings = self->settings;
+
+  // band 0 has no split frequency
+
+  gtk_widget_set_visible(GTK_WIDGET(self->split_frequency), index > 0 ? 1 : 0);
+  gtk_widget_set_visible(GTK_WIDGET(self->split_frequency_zero), index > 0 ? 0 : 1);
+
+  if (index > 0) {
+    g_settings_bind(settings, band_split_frequency[index].data(), gtk_spin_button_get_adjustment(self->split_frequency),
+                    "value", G_SETTINGS_BIND_DEFAULT);
   }
 
   g_settings_bind(self->settings, band_gate_enable[index].data(), self->bypass, "active",
@@ -203,13 +249,6 @@ void setup(MultibandGateBandBox* self, GSettings* settings, int index) {
 
   g_settings_bind(settings, band_sidechain_lookahead[index].data(),
                   gtk_spin_button_get_adjustment(self->sidechain_lookahead), "value", G_SETTINGS_BIND_DEFAULT);
-
-  // bind source dropdowns sensitive property to split-stereo gsettings boolean
-
-  g_settings_bind(self->settings, "stereo-split", self->sidechain_source, "sensitive",
-                  static_cast<GSettingsBindFlags>(G_SETTINGS_BIND_DEFAULT | G_SETTINGS_BIND_INVERT_BOOLEAN));
-
-  g_settings_bind(self->settings, "stereo-split", self->stereo_split_source, "sensitive", G_SETTINGS_BIND_DEFAULT);
 }
 
 void dispose(GObject* object) {
@@ -255,6 +294,7 @@ void multiband_gate_band_box_class_init(MultibandGateBandBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, MultibandGateBandBox, curve_label);
   gtk_widget_class_bind_template_child(widget_class, MultibandGateBandBox, split_frequency);
   gtk_widget_class_bind_template_child(widget_class, MultibandGateBandBox, split_frequency_box);
+  gtk_widget_class_bind_template_child(widget_class, MultibandGateBandBox, split_frequency_zero);
   gtk_widget_class_bind_template_child(widget_class, MultibandGateBandBox, lowcut_filter);
   gtk_widget_class_bind_template_child(widget_class, MultibandGateBandBox, highcut_filter);
   gtk_widget_class_bind_template_child(widget_class, MultibandGateBandBox, lowcut_filter_frequency);
@@ -29,7 +29,6 @@
 #include <gtk/gtkdropdown.h>
 #include <gtk/gtksingleselection.h>
 #include <sigc++/connection.h>
-#include <array>
 #include <cstddef>
 #include <memory>
 #include <string>
@@ -58,6 +57,8 @@ struct Data {
 
   std::shared_ptr<MultibandGate> multiband_gate;
 
+  int selected_band = 0;
+
   std::vector<sigc::connection> connections;
 
   std::vector<gulong> gconnections;
@@ -73,7 +74,7 @@ struct _MultibandGateBox {
   GtkLabel *input_level_left_label, *input_level_right_label, *output_level_left_label, *output_level_right_label,
       *plugin_credit;
 
-  GtkStack* stack;
+  GtkBox* band_container;
 
   GtkCheckButton *enable_band1, *enable_band2, *enable_band3, *enable_band4, *enable_band5, *enable_band6,
       *enable_band7;
@@ -90,7 +91,7 @@ struct _MultibandGateBox {
 
   GSettings* settings;
 
-  std::array<ui::multiband_gate_band_box::MultibandGateBandBox*, tags::multiband_gate::n_bands> bands;
+  ui::multiband_gate_band_box::MultibandGateBandBox* band_box;
 
   Data* data;
 };
@@ -113,7 +114,9 @@ void on_show_native_window(MultibandGateBox* self, GtkToggleButton* btn) {
 void on_listbox_row_selected(MultibandGateBox* self, GtkListBoxRow* row, GtkListBox* listbox) {
   if (auto* selected_row = gtk_list_box_get_selected_row(listbox); selected_row != nullptr) {
     if (auto index = gtk_list_box_row_get_index(selected_row); index != -1) {
-      gtk_stack_set_visible_child_name(self->stack, ("band" + util::to_string(index)).c_str());
+      self->data->selected_band = index;
+
+      ui::multiband_gate_band_box::bind(self->band_box, index);
     }
   }
 }
@@ -131,15 +134,17 @@ void set_dropdown_input_devices_sensitivity(MultibandGateBox* self) {
 }
 
 void create_bands(MultibandGateBox* self) {
-  for (uint n = 0U; n < tags::multiband_gate::n_bands; n++) {
-    auto* band_box = ui::multiband_gate_band_box::create();
+  // a single band box is rebound to the selected band instead of having one box per band
 
-    ui::multiband_gate_band_box::setup(band_box, self->settings, static_cast<int>(n));
+  self->band_box = ui::multiband_gate_band_box::create();
 
-    gtk_stack_add_named(self->stack, GTK_WIDGET(band_box), ("band" + util::to_string(n)).c_str());
+  ui::multiband_gate_band_box::setup(self->band_box, self->settings);
 
-    self->bands[n] = band_box;
+  ui::multiband_gate_band_box::bind(self->band_box, 0);
 
+  gtk_box_append(self->band_container, GTK_WIDGET(self->band_box));
+
+  for (uint n = 0U; n < tags::multiband_gate::n_bands; n++) {
     self->data->gconnections.push_back(g_signal_connect(
         self->settings, ("changed::"s + tags::multiband_gate::band_external_sidechain[n].data()).c_str(),
         G_CALLBACK(+[](GSettings* settings, char* key, MultibandGateBox* self) {
@@ -198,7 +203,8 @@ void setup(MultibandGateBox* self,
 
     if (node.media_class == tags::pipewire::media_class::source ||
         node.media_class == tags::pipewire::media_class::virtual_source ||
-        node.media_role == tags::pipewire::media_role::dsp) {
+        node.media_role == tags::pipewire::media_role::dsp ||
+        node.media_class == tags::pipewire::media_class::output_stream) {
       auto* holder = ui::holders::create(node);
 
       g_list_store_append(self->input_devices_model, holder);
@@ -207,6 +213,8 @@ void setup(MultibandGateBox* self,
     }
   }
 
+  ui::setup_sidechain_sources(self->input_devices_model, pm, self->data->connections);
+
   self->data->connections.push_back(multiband_gate->input_level.connect([=](const float left, const float right) {
     g_object_ref(self);
 
@@ -237,73 +245,26 @@ void setup(MultibandGateBox* self,
         [=]() { g_object_unref(self); });
   }));
 
-  self->data->connections.push_back(
-      multiband_gate->frequency_range.connect([=](const std::array<float, tags::multiband_gate::n_bands> values) {
-        g_object_ref(self);
-
-        util::idle_add(
-            [=]() {
-              if (get_ignore_filter_idle_add(serial)) {
-                return;
-              }
-
-              for (size_t n = 0U; n < values.size(); n++) {
-                ui::multiband_gate_band_box::set_end_label(self->bands[n], values[n]);
-              }
-            },
-            [=]() { g_object_unref(self); });
-      }));
-
-  self->data->connections.push_back(
-      multiband_gate->envelope.connect([=](const std::array<float, tags::multiband_gate::n_bands> values) {
-        g_object_ref(self);
-
-        util::idle_add(
-            [=]() {
-              if (get_ignore_filter_idle_add(serial)) {
-                return;
-              }
-
-              for (size_t n = 0U; n < values.size(); n++) {
-                ui::multiband_gate_band_box::set_envelope_label(self->bands[n], values[n]);
-              }
-            },
-            [=]() { g_object_unref(self); });
-      }));
-
-  self->data->connections.push_back(
-      multiband_gate->curve.connect([=](const std::array<float, tags::multiband_gate::n_bands> values) {
-        g_object_ref(self);
-
-        util::idle_add(
-            [=]() {
-              if (get_ignore_filter_idle_add(serial)) {
-                return;
-              }
-
-              for (size_t n = 0U; n < values.size(); n++) {
-                ui::multiband_gate_band_box::set_curve_label(self->bands[n], values[n]);
-              }
-            },
-            [=]() { g_object_unref(self); });
-      }));
-
-  self->data->connections.push_back(
-      multiband_gate->reduction.connect([=](const std::array<float, tags::multiband_gate::n_bands> values) {
-        g_object_ref(self);
-
-        util::idle_add(
-            [=]() {
-              if (get_ignore_filter_idle_add(serial)) {
-                return;
-              }
-
-              for (size_t n = 0U; n < values.size(); n++) {
-                ui::multiband_gate_band_box::set_gain_label(self->bands[n], values[n]);
-              }
-            },
-            [=]() { g_object_unref(self); });
-      }));
+  self->data->connections.push_back(multiband_gate->band_meters.connect([=](const MultibandGate::BandMeters meters) {
+    g_object_ref(self);
+
+    util::idle_add(
+        [=]() {
+          if (get_ignore_filter_idle_add(serial)) {
+            return;
+          }
+
+          // only the selected band is visible
+
+          const auto n = static_cast<size_t>(self->data->selected_band);
+
+          ui::multiband_gate_band_box::set_end_label(self->band_box, meters.frequency_range_end[n]);
+          ui::multiband_gate_band_box::set_envelope_label(self->band_box, meters.envelope[n]);
+          ui::multiband_gate_band_box::set_curve_label(self->band_box, meters.curve[n]);
+          ui::multiband_gate_band_box::set_gain_label(self->band_box, meters.reduction[n]);
+        },
+        [=]() { g_object_unref(self); });
+  }));
 
   self->data->connections.push_back(pm->source_added.connect([=](const NodeInfo info) {
     for (guint n = 0U; n < g_list_model_get_n_items(G_LIST_MODEL(self->input_devices_model)); n++) {
@@ -426,7 +387,7 @@ void multiband_gate_box_class_init(MultibandGateBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, MultibandGateBox, output_level_right_label);
   gtk_widget_class_bind_template_child(widget_class, MultibandGateBox, plugin_credit);
 
-  gtk_widget_class_bind_template_child(widget_class, MultibandGateBox, stack);
+  gtk_widget_class_bind_template_child(widget_class, MultibandGateBox, band_container);
   gtk_widget_class_bind_template_child(widget_class, MultibandGateBox, enable_band1);
   gtk_widget_class_bind_template_child(widget_class, MultibandGateBox, enable_band2);
   gtk_widget_class_bind_template_child(widget_class, MultibandGateBox, enable_band3);
@@ -159,6 +159,8 @@ auto create(const NodeInfo& info) -> NodeInfoHolder* {
   } else if (info.media_class == tags::pipewire::media_class::source ||
              info.media_class == tags::pipewire::media_class::virtual_source || info.name.starts_with("ee_sie")) {
     holder->icon_name = "audio-input-microphone-symbolic";
+  } else if (info.media_class == tags::pipewire::media_class::output_stream) {
+    holder->icon_name = "applications-multimedia-symbolic";
   }
 
   return holder;
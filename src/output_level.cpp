@@ -22,6 +22,7 @@
 #include <span>
 #include <string>
 #include "pipe_manager.hpp"
+#include "pipeline_type.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
@@ -44,6 +45,8 @@ OutputLevel::~OutputLevel() {
 void OutputLevel::setup() {
   util::debug(log_tag + name + ": PipeWire blocksize: " + util::to_string(n_samples, ""));
   util::debug(log_tag + name + ": PipeWire sampling rate: " + util::to_string(rate, ""));
+
+  ducker.setup(rate);
 }
 
 void OutputLevel::process(std::span<float>& left_in,
@@ -53,6 +56,10 @@ void OutputLevel::process(std::span<float>& left_in,
   std::copy(left_in.begin(), left_in.end(), left_out.begin());
   std::copy(right_in.begin(), right_in.end(), right_out.begin());
 
+  if (pipeline_type == PipelineType::output) {
+    ducker.process(left_out, right_out);
+  }
+
   if (post_messages) {
     get_peaks(left_in, right_in, left_out, right_out);
 
@@ -18,6 +18,8 @@
  */
 
 #include "pipe_manager.hpp"
+#include <gio/gio.h>
+#include <glib-object.h>
 #include <glib.h>
 #include <pipewire/client.h>
 #include <pipewire/context.h>
@@ -58,13 +60,19 @@
 #include <array>
 #include <cerrno>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <ctime>
+#include <map>
+#include <mutex>
+#include <ranges>
+#include <set>
 #include <span>
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 #include "pipe_objects.hpp"
 #include "tags_app.hpp"
@@ -229,7 +237,8 @@ void on_destroy_node_proxy(void* data) {
 
         pm->source_removed.emit(nd_info_copy);
       });
-    } else if (nd->nd_info->media_class == tags::pipewire::media_class::sink) {
+    } else if (nd->nd_info->media_class == tags::pipewire::media_class::sink &&
+               !nd->nd_info->name.starts_with(tags::pipewire::ee_app_chain_sink_prefix)) {
       const auto nd_info_copy = *nd->nd_info;
 
       util::idle_add([=]() {
@@ -855,6 +864,16 @@ void on_module_info(void* object, const struct pw_module_info* info) {
 
       spa_dict_get_string(info->props, PW_KEY_MODULE_DESCRIPTION, module.description);
 
+      const auto module_copy = module;
+
+      util::idle_add([=, pm = md->pm]() {
+        if (PipeManager::exiting) {
+          return;
+        }
+
+        pm->module_changed.emit(module_copy);
+      });
+
       break;
     }
   }
@@ -868,6 +887,14 @@ void on_destroy_module_proxy(void* data) {
   md->pm->list_modules.erase(std::remove_if(md->pm->list_modules.begin(), md->pm->list_modules.end(),
                                             [=](const auto& n) { return n.id == md->id; }),
                              md->pm->list_modules.end());
+
+  util::idle_add([pm = md->pm, id = md->id]() {
+    if (PipeManager::exiting) {
+      return;
+    }
+
+    pm->module_removed.emit(id);
+  });
 }
 
 void on_client_info(void* object, const struct pw_client_info* info) {
@@ -881,6 +908,16 @@ void on_client_info(void* object, const struct pw_client_info* info) {
 
       spa_dict_get_string(info->props, PW_KEY_CLIENT_API, client.api);
 
+      const auto client_copy = client;
+
+      util::idle_add([=, pm = cd->pm]() {
+        if (PipeManager::exiting) {
+          return;
+        }
+
+        pm->client_changed.emit(client_copy);
+      });
+
       break;
     }
   }
@@ -894,6 +931,14 @@ void on_destroy_client_proxy(void* data) {
   cd->pm->list_clients.erase(std::remove_if(cd->pm->list_clients.begin(), cd->pm->list_clients.end(),
                                             [=](const auto& n) { return n.serial == cd->serial; }),
                              cd->pm->list_clients.end());
+
+  util::idle_add([pm = cd->pm, id = cd->id]() {
+    if (PipeManager::exiting) {
+      return;
+    }
+
+    pm->client_removed.emit(id);
+  });
 }
 
 void on_device_info(void* object, const struct pw_device_info* info) {
@@ -1273,7 +1318,8 @@ void on_registry_global(void* data,
 
         pm->source_added.emit(nd_info_copy);
       });
-    } else if (media_class == tags::pipewire::media_class::sink && node_name != tags::pipewire::ee_sink_name) {
+    } else if (media_class == tags::pipewire::media_class::sink && node_name != tags::pipewire::ee_sink_name &&
+               !node_name.starts_with(tags::pipewire::ee_app_chain_sink_prefix)) {
       util::idle_add([pm, nd_info_copy] {
         if (PipeManager::exiting) {
           return;
@@ -1281,6 +1327,15 @@ void on_registry_global(void* data,
 
         pm->sink_added.emit(nd_info_copy);
       });
+    } else if (media_class == tags::pipewire::media_class::sink &&
+               node_name.starts_with(tags::pipewire::ee_app_chain_sink_prefix)) {
+      util::idle_add([pm, nd_info_copy] {
+        if (PipeManager::exiting) {
+          return;
+        }
+
+        pm->app_chain_sink_added.emit(nd_info_copy);
+      });
     } else if (media_class == tags::pipewire::media_class::output_stream) {
       util::idle_add([pm, nd_info_copy] {
         if (PipeManager::exiting) {
@@ -1424,6 +1479,14 @@ void on_registry_global(void* data,
 
     pm->list_modules.push_back(m_info);
 
+    util::idle_add([=]() {
+      if (PipeManager::exiting) {
+        return;
+      }
+
+      pm->module_added.emit(m_info);
+    });
+
     return;
   }
 
@@ -1457,6 +1520,14 @@ void on_registry_global(void* data,
 
     pm->list_clients.push_back(c_info);
 
+    util::idle_add([=]() {
+      if (PipeManager::exiting) {
+        return;
+      }
+
+      pm->client_added.emit(c_info);
+    });
+
     return;
   }
 
@@ -1584,6 +1655,8 @@ const struct pw_registry_events registry_events = {
 }  // namespace
 
 PipeManager::PipeManager() : header_version(pw_get_headers_version()), library_version(pw_get_library_version()) {
+  settings = g_settings_new(tags::app::id);
+
   pw_init(nullptr, nullptr);
 
   spa_zero(core_listener);
@@ -1657,25 +1730,27 @@ PipeManager::PipeManager() : header_version(pw_get_headers_version()), library_v
 
   pw_properties_free(props_sink);
 
-  // loading our source
+  // loading our source. When it is a filter it is created later by the input pipeline
 
-  pw_properties* props_source = pw_properties_new(nullptr, nullptr);
+  if (!ee_source_is_filter) {
+    pw_properties* props_source = pw_properties_new(nullptr, nullptr);
 
-  pw_properties_set(props_source, PW_KEY_APP_ID, tags::app::id);
-  pw_properties_set(props_source, PW_KEY_NODE_NAME, tags::pipewire::ee_source_name);
-  pw_properties_set(props_source, PW_KEY_NODE_DESCRIPTION, "Easy Effects Source");
-  pw_properties_set(props_source, PW_KEY_NODE_VIRTUAL, "true");
-  pw_properties_set(props_source, "factory.name", "support.null-audio-sink");
-  pw_properties_set(props_source, PW_KEY_MEDIA_CLASS, tags::pipewire::media_class::virtual_source);
-  pw_properties_set(props_source, "audio.position", "FL,FR");
-  pw_properties_set(props_source, "monitor.channel-volumes", "false");
-  pw_properties_set(props_source, "monitor.passthrough", "true");
-  pw_properties_set(props_source, "priority.session", "0");
+    pw_properties_set(props_source, PW_KEY_APP_ID, tags::app::id);
+    pw_properties_set(props_source, PW_KEY_NODE_NAME, tags::pipewire::ee_source_name);
+    pw_properties_set(props_source, PW_KEY_NODE_DESCRIPTION, "Easy Effects Source");
+    pw_properties_set(props_source, PW_KEY_NODE_VIRTUAL, "true");
+    pw_properties_set(props_source, "factory.name", "support.null-audio-sink");
+    pw_properties_set(props_source, PW_KEY_MEDIA_CLASS, tags::pipewire::media_class::virtual_source);
+    pw_properties_set(props_source, "audio.position", "FL,FR");
+    pw_properties_set(props_source, "monitor.channel-volumes", "false");
+    pw_properties_set(props_source, "monitor.passthrough", "true");
+    pw_properties_set(props_source, "priority.session", "0");
 
-  proxy_stream_input_source = static_cast<pw_proxy*>(
-      pw_core_create_object(core, "adapter", PW_TYPE_INTERFACE_Node, PW_VERSION_NODE, &props_source->dict, 0));
+    proxy_stream_input_source = static_cast<pw_proxy*>(
+        pw_core_create_object(core, "adapter", PW_TYPE_INTERFACE_Node, PW_VERSION_NODE, &props_source->dict, 0));
 
-  pw_properties_free(props_source);
+    pw_properties_free(props_source);
+  }
 
   sync_wait_unlock();
 
@@ -1697,7 +1772,7 @@ PipeManager::PipeManager() : header_version(pw_get_headers_version()), library_v
                     util::to_string(node.id) + " and serial " + util::to_string(node.serial));
       }
     }
-  } while (ee_sink_node.id == SPA_ID_INVALID || ee_source_node.id == SPA_ID_INVALID);
+  } while (ee_sink_node.id == SPA_ID_INVALID || (!ee_source_is_filter && ee_source_node.id == SPA_ID_INVALID));
 }
 
 PipeManager::~PipeManager() {
@@ -1714,7 +1789,14 @@ PipeManager::~PipeManager() {
   }
 
   pw_proxy_destroy(proxy_stream_output_sink);
-  pw_proxy_destroy(proxy_stream_input_source);
+
+  for (auto* proxy : app_chain_sink_proxies | std::views::values) {
+    pw_proxy_destroy(proxy);
+  }
+
+  if (proxy_stream_input_source != nullptr) {
+    pw_proxy_destroy(proxy_stream_input_source);
+  }
 
   util::debug("Destroying PipeWire registry...");
   pw_proxy_destroy((struct pw_proxy*)registry);
@@ -1730,6 +1812,8 @@ PipeManager::~PipeManager() {
   util::debug("Destroying PipeWire's context...");
   pw_context_destroy(context);
 
+  g_object_unref(settings);
+
   util::debug("Destroying PipeWire's loop...");
   pw_thread_loop_destroy(thread_loop);
 }
@@ -1748,8 +1832,12 @@ auto PipeManager::node_map_at_id(const uint& id) -> NodeInfo& {
 
 auto PipeManager::stream_is_connected(const uint& id, const std::string& media_class) -> bool {
   if (media_class == tags::pipewire::media_class::output_stream) {
+    const auto route = app_chain_routes.find(id);
+
+    const auto sink_id = (route != app_chain_routes.end()) ? route->second.id : ee_sink_node.id;
+
     for (const auto& link : list_links) {
-      if (link.output_node_id == id && link.input_node_id == ee_sink_node.id) {
+      if (link.output_node_id == id && link.input_node_id == sink_id) {
         return true;
       }
     }
@@ -1765,6 +1853,12 @@ auto PipeManager::stream_is_connected(const uint& id, const std::string& media_c
 }
 
 void PipeManager::connect_stream_output(const uint& id) const {
+  if (const auto route = app_chain_routes.find(id); route != app_chain_routes.end()) {
+    set_metadata_target_node(id, route->second.id, route->second.serial);
+
+    return;
+  }
+
   set_metadata_target_node(id, ee_sink_node.id, ee_sink_node.serial);
 }
 
@@ -1802,36 +1896,211 @@ void PipeManager::disconnect_stream(const uint& stream_id) const {
   sync_wait_unlock();
 }
 
-void PipeManager::set_node_volume(pw_proxy* proxy, const uint& n_vol_ch, const float& value) const {
-  std::array<float, SPA_AUDIO_MAX_CHANNELS> volumes{};
+auto PipeManager::create_app_chain_sink(const std::string& name, const std::string& description) -> bool {
+  if (app_chain_sink_proxies.contains(name)) {
+    util::warning("the sink " + name + " already exists");
 
-  std::ranges::fill(volumes, 0.0F);
-  std::fill_n(volumes.begin(), n_vol_ch, value);
+    return false;
+  }
 
-  std::array<char, 1024U> buffer{};
+  lock();
 
-  auto builder = SPA_POD_BUILDER_INIT(buffer.data(), sizeof(buffer));
+  pw_properties* props_sink = pw_properties_new(nullptr, nullptr);
+
+  pw_properties_set(props_sink, PW_KEY_APP_ID, tags::app::id);
+  pw_properties_set(props_sink, PW_KEY_NODE_NAME, name.c_str());
+  pw_properties_set(props_sink, PW_KEY_NODE_DESCRIPTION, description.c_str());
+  pw_properties_set(props_sink, PW_KEY_NODE_VIRTUAL, "true");
+  pw_properties_set(props_sink, PW_KEY_NODE_PASSIVE, "out");
+  pw_properties_set(props_sink, "factory.name", "support.null-audio-sink");
+  pw_properties_set(props_sink, PW_KEY_MEDIA_CLASS, tags::pipewire::media_class::sink);
+  pw_properties_set(props_sink, "audio.position", "FL,FR");
+  pw_properties_set(props_sink, "monitor.channel-volumes", "false");
+  pw_properties_set(props_sink, "monitor.passthrough", "true");
+  pw_properties_set(props_sink, "priority.session", "0");
+
+  app_chain_sink_proxies[name] = static_cast<pw_proxy*>(
+      pw_core_create_object(core, "adapter", PW_TYPE_INTERFACE_Node, PW_VERSION_NODE, &props_sink->dict, 0));
+
+  pw_properties_free(props_sink);
+
+  sync_wait_unlock();
+
+  return true;
+}
+
+void PipeManager::destroy_app_chain_sink(const std::string& name) {
+  const auto it = app_chain_sink_proxies.find(name);
+
+  if (it == app_chain_sink_proxies.end()) {
+    return;
+  }
 
   lock();
 
-  pw_node_set_param(
-      (struct pw_node*)proxy, SPA_PARAM_Props, 0,
-      (spa_pod*)spa_pod_builder_add_object(&builder, SPA_TYPE_OBJECT_Props, SPA_PARAM_Props, SPA_PROP_channelVolumes,
-                                           SPA_POD_Array(sizeof(float), SPA_TYPE_Float, n_vol_ch, volumes.data())));
+  pw_proxy_destroy(it->second);
 
   sync_wait_unlock();
+
+  app_chain_sink_proxies.erase(it);
 }
 
-void PipeManager::set_node_mute(pw_proxy* proxy, const bool& state) const {
-  std::array<char, 1024U> buffer{};
+void PipeManager::set_app_chain_route(const uint& stream_id, const NodeInfo& sink) {
+  lock();
+
+  app_chain_routes[stream_id] = sink;
+
+  unlock();
+}
+
+void PipeManager::remove_app_chain_route(const uint& stream_id) {
+  lock();
+
+  app_chain_routes.erase(stream_id);
+
+  unlock();
+}
+
+void PipeManager::set_node_volume(const uint64_t& serial, const uint& n_vol_ch, const float& value) {
+  bool schedule = false;
+
+  {
+    std::scoped_lock<std::mutex> lock(pending_node_controls_mutex);
+
+    auto& control = pending_node_controls[serial];
+
+    control.volume = value;
+    control.n_vol_ch = n_vol_ch;
+
+    schedule = !std::exchange(node_controls_flush_scheduled, true);
+  }
+
+  if (schedule) {
+    schedule_node_controls_flush();
+  }
+}
+
+void PipeManager::set_node_mute(const uint64_t& serial, const bool& state) {
+  bool schedule = false;
 
-  auto builder = SPA_POD_BUILDER_INIT(buffer.data(), sizeof(buffer));
+  {
+    std::scoped_lock<std::mutex> lock(pending_node_controls_mutex);
+
+    pending_node_controls[serial].mute = state;
+
+    schedule = !std::exchange(node_controls_flush_scheduled, true);
+  }
+
+  if (schedule) {
+    schedule_node_controls_flush();
+  }
+}
+
+auto PipeManager::get_streams(const std::string& media_class, const std::string& media_role)
+    -> std::vector<std::pair<uint64_t, uint>> {
+  std::vector<std::pair<uint64_t, uint>> streams;
 
   lock();
 
-  pw_node_set_param((pw_node*)proxy, SPA_PARAM_Props, 0,
-                    (spa_pod*)spa_pod_builder_add_object(&builder, SPA_TYPE_OBJECT_Props, SPA_PARAM_Props,
-                                                         SPA_PROP_mute, SPA_POD_Bool(state)));
+  for (const auto& [serial, node] : node_map) {
+    if (node.media_class == media_class && (media_role.empty() || node.media_role == media_role)) {
+      streams.emplace_back(serial, node.n_volume_channels);
+    }
+  }
+
+  unlock();
+
+  return streams;
+}
+
+auto PipeManager::slider_to_volume(const float& value) const -> float {
+  return (g_settings_get_boolean(settings, "use-cubic-volumes") != 0) ? value * value * value : value;
+}
+
+void PipeManager::set_streams_volume(const std::string& media_class,
+                                     const std::string& media_role,
+                                     const float& value) {
+  const auto volume = slider_to_volume(value);
+
+  for (const auto& [serial, n_vol_ch] : get_streams(media_class, media_role)) {
+    set_node_volume(serial, n_vol_ch, volume);
+  }
+}
+
+void PipeManager::set_streams_mute(const std::string& media_class, const std::string& media_role, const bool& state) {
+  for (const auto& [serial, n_vol_ch] : get_streams(media_class, media_role)) {
+    set_node_mute(serial, state);
+  }
+}
+
+void PipeManager::schedule_node_controls_flush() {
+  // all the changes made until the main loop is idle again are sent together
+
+  util::idle_add([this]() {
+    if (PipeManager::exiting) {
+      return;
+    }
+
+    flush_node_controls();
+  });
+}
+
+void PipeManager::flush_node_controls() {
+  std::map<uint64_t, PendingNodeControl> pending;
+
+  {
+    std::scoped_lock<std::mutex> lock(pending_node_controls_mutex);
+
+    pending.swap(pending_node_controls);
+
+    node_controls_flush_scheduled = false;
+  }
+
+  if (pending.empty()) {
+    return;
+  }
+
+  std::array<float, SPA_AUDIO_MAX_CHANNELS> volumes{};
+
+  std::array<char, 1024U> buffer{};
+
+  lock();
+
+  for (const auto& [serial, control] : pending) {
+    const auto node_it = node_map.find(serial);
+
+    // the node may have been removed while the change was pending
+
+    if (node_it == node_map.end() || node_it->second.proxy == nullptr) {
+      continue;
+    }
+
+    auto builder = SPA_POD_BUILDER_INIT(buffer.data(), sizeof(buffer));
+
+    spa_pod_frame frame{};
+
+    spa_pod_builder_push_object(&builder, &frame, SPA_TYPE_OBJECT_Props, SPA_PARAM_Props);
+
+    if (control.volume.has_value()) {
+      const auto n_vol_ch = std::min(control.n_vol_ch, static_cast<uint>(SPA_AUDIO_MAX_CHANNELS));
+
+      std::fill_n(volumes.begin(), n_vol_ch, control.volume.value());
+
+      spa_pod_builder_prop(&builder, SPA_PROP_channelVolumes, 0);
+      spa_pod_builder_array(&builder, sizeof(float), SPA_TYPE_Float, n_vol_ch, volumes.data());
+    }
+
+    if (control.mute.has_value()) {
+      spa_pod_builder_prop(&builder, SPA_PROP_mute, 0);
+      spa_pod_builder_bool(&builder, control.mute.value());
+    }
+
+    auto* param = static_cast<spa_pod*>(spa_pod_builder_pop(&builder, &frame));
+
+    pw_node_set_param((pw_node*)node_it->second.proxy, SPA_PARAM_Props, 0, param);
+  }
+
+  // one roundtrip for all the nodes
 
   sync_wait_unlock();
 }
@@ -1848,6 +2117,139 @@ auto PipeManager::count_node_ports(const uint& node_id) -> uint {
   return count;
 }
 
+void PipeManager::set_ee_source_filter(const uint& node_id) {
+  using namespace std::string_literals;
+
+  if (node_id == SPA_ID_INVALID) {
+    util::warning("the filter that should be our virtual source is not connected to PipeWire");
+
+    return;
+  }
+
+  // the node map is filled by the PipeWire thread
+
+  for (int timeout = 0; timeout < 10000 && ee_source_node.id != node_id; timeout++) {  // 10 seconds
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    lock();
+
+    for (const auto& node : node_map | std::views::values) {
+      if (node.id == node_id) {
+        ee_source_node = node;
+
+        break;
+      }
+    }
+
+    unlock();
+  }
+
+  if (ee_source_node.id != node_id) {
+    util::warning("the filter " + util::to_string(node_id) + " that should be our virtual source is taking too long" +
+                  " to be available");
+
+    return;
+  }
+
+  util::debug(tags::pipewire::ee_source_name + " filter successfully retrieved with id "s +
+              util::to_string(ee_source_node.id) + " and serial " + util::to_string(ee_source_node.serial));
+}
+
+auto PipeManager::get_memory_usage() const -> size_t {
+  lock();
+
+  // Each std::map node also stores its key and the tree pointers
+
+  const auto bytes = (node_map.size() * (sizeof(uint64_t) + sizeof(NodeInfo) + (4U * sizeof(void*)))) +
+                     util::container_bytes(list_links) + util::container_bytes(list_ports) +
+                     util::container_bytes(list_modules) + util::container_bytes(list_clients) +
+                     util::container_bytes(list_devices);
+
+  unlock();
+
+  return bytes;
+}
+
+auto PipeManager::is_downstream(const uint& origin_id, const uint& node_id) -> bool {
+  std::vector<uint> pending = {origin_id};
+  std::set<uint> visited;
+
+  while (!pending.empty()) {
+    const auto id = pending.back();
+
+    pending.pop_back();
+
+    if (!visited.insert(id).second) {
+      continue;
+    }
+
+    for (const auto& link : list_links) {
+      if (link.output_node_id != id) {
+        continue;
+      }
+
+      if (link.input_node_id == node_id) {
+        return true;
+      }
+
+      pending.push_back(link.input_node_id);
+    }
+  }
+
+  return false;
+}
+
+auto PipeManager::feeds_pipeline_end(const std::string& end_name, const uint& node_id) -> bool {
+  std::string pipeline_tag;
+
+  if (end_name == tags::pipewire::ee_output_pipeline_end) {
+    pipeline_tag = "soe_";
+  } else if (end_name == tags::pipewire::ee_input_pipeline_end) {
+    pipeline_tag = "sie_";
+  } else {
+    return false;
+  }
+
+  // The filters of a pipeline and of the preset stage crossfading into it are named after the pipeline log tag. See
+  // PluginBase::PluginBase
+
+  for (const auto& [filter_name, id] : filter_nodes) {
+    if (id == node_id) {
+      return filter_name.starts_with("ee_" + pipeline_tag) || filter_name.starts_with("ee_stage_" + pipeline_tag);
+    }
+  }
+
+  return false;
+}
+
+auto PipeManager::link_sidechain(const std::string& source_name, const uint& node_id) -> std::vector<pw_proxy*> {
+  auto source_id = ee_source_node.id;
+
+  if (const auto it = filter_nodes.find(source_name); it != filter_nodes.end()) {
+    source_id = it->second;
+  } else {
+    for (const auto& [serial, node] : node_map) {
+      if (node.name == source_name) {
+        source_id = node.id;
+
+        break;
+      }
+    }
+  }
+
+  // list_links only learns about the links we have just created when the registry events arrive. So a plugin asking
+  // for the end of its own pipeline is refused by name
+
+  if (source_id == node_id || feeds_pipeline_end(source_name, node_id) || is_downstream(node_id, source_id)) {
+    util::warning("the sidechain source " + source_name + " is fed by node " + util::to_string(node_id) +
+                  ". Linking it would create a cycle");
+
+    return {};
+  }
+
+  return link_nodes(source_id, node_id, true);
+}
+
 auto PipeManager::link_nodes(const uint& output_node_id,
                              const uint& input_node_id,
                              const bool& probe_link,
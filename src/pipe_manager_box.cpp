@@ -33,6 +33,7 @@
 #include <memory>
 #include <nlohmann/json_fwd.hpp>
 #include <string>
+#include <utility>
 #include <vector>
 #include "application.hpp"
 #include "client_info_holder.hpp"
@@ -41,7 +42,9 @@
 #include "pipe_objects.hpp"
 #include "preset_type.hpp"
 #include "presets_autoloading_holder.hpp"
+#include "stream_input_effects.hpp"
 #include "tags_pipewire.hpp"
+#include "tags_plugin_name.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "test_signals.hpp"
@@ -63,15 +66,20 @@ struct Data {
   std::vector<sigc::connection> connections;
 
   std::vector<gulong> gconnections_sie, gconnections_soe;
+
+  std::vector<std::string> compared_denoisers;
+
+  bool updating_compared_denoisers = false;
 };
 
 struct _PipeManagerBox {
   GtkBox parent_instance;
 
-  GtkSwitch *use_default_input, *use_default_output, *enable_test_signal;
+  GtkSwitch *use_default_input, *use_default_output, *enable_test_signal, *denoiser_comparison, *ducking;
 
   GtkDropDown *dropdown_input_devices, *dropdown_output_devices, *dropdown_autoloading_output_devices,
-      *dropdown_autoloading_input_devices, *dropdown_autoloading_output_presets, *dropdown_autoloading_input_presets;
+      *dropdown_autoloading_input_devices, *dropdown_autoloading_output_presets, *dropdown_autoloading_input_presets,
+      *dropdown_compared_denoisers;
 
   GtkListView *listview_modules, *listview_clients, *listview_autoloading_output, *listview_autoloading_input;
 
@@ -79,12 +87,12 @@ struct _PipeManagerBox {
 
   GtkLabel *header_version, *library_version, *quantum, *max_quantum, *min_quantum, *server_rate;
 
-  GtkSpinButton* spinbutton_test_signal_frequency;
+  GtkSpinButton *spinbutton_test_signal_frequency, *ducking_reduction, *ducking_attack, *ducking_release;
 
   GListStore *input_devices_model, *output_devices_model, *modules_model, *clients_model, *autoloading_input_model,
       *autoloading_output_model, *autoloading_input_devices_model, *autoloading_output_devices_model;
 
-  GtkStringList *input_presets_string_list, *output_presets_string_list;
+  GtkStringList *input_presets_string_list, *output_presets_string_list, *compared_denoisers_string_list;
 
   GSettings *sie_settings, *soe_settings;
 
@@ -230,43 +238,155 @@ void on_autoloading_add_output_profile(PipeManagerBox* self, GtkButton* btn) {
                                                          holder->info->description, device_profile);
 }
 
-void update_modules_info(PipeManagerBox* self) {
-  std::vector<ui::holders::ModuleInfoHolder*> values;
+/*
+  The device, module and client stores are sorted by object id. The row of an object is found with a binary search, so
+  an event only touches the row it is about. Rebuilding or scanning the stores stalls the page when the graph has
+  hundreds of objects changing at the same time.
+*/
+
+// Position of the row with this id or the position where it has to be inserted
 
-  for (const auto& info : self->data->application->pm->list_modules) {
-    values.push_back(ui::holders::create(info));
-  }
+template <typename Holder>
+auto find_row(GListStore* store, const uint& id) -> std::pair<guint, bool> {
+  guint begin = 0U;
+  guint end = g_list_model_get_n_items(G_LIST_MODEL(store));
+
+  while (begin < end) {
+    const auto middle = begin + ((end - begin) / 2U);
 
-  g_list_store_splice(self->modules_model, 0, g_list_model_get_n_items(G_LIST_MODEL(self->modules_model)),
-                      (gpointer*)(values.data()), values.size());
+    auto* holder = static_cast<Holder*>(g_list_model_get_item(G_LIST_MODEL(store), middle));
+
+    const auto middle_id = holder->info->id;
 
-  for (auto* holder : values) {
     g_object_unref(holder);
+
+    if (middle_id == id) {
+      return {middle, true};
+    }
+
+    if (middle_id < id) {
+      begin = middle + 1U;
+    } else {
+      end = middle;
+    }
   }
+
+  return {begin, false};
 }
 
-void update_clients_info(PipeManagerBox* self) {
-  std::vector<ui::holders::ClientInfoHolder*> values;
+template <typename Holder, typename Info>
+void add_row(GListStore* store, const Info& info) {
+  const auto [position, found] = find_row<Holder>(store, info.id);
 
-  for (const auto& info : self->data->application->pm->list_clients) {
-    values.push_back(ui::holders::create(info));
+  if (found) {
+    return;
   }
 
-  g_list_store_splice(self->clients_model, 0, g_list_model_get_n_items(G_LIST_MODEL(self->clients_model)),
-                      (gpointer*)(values.data()), values.size());
+  auto* holder = ui::holders::create(info);
 
-  for (auto* holder : values) {
-    g_object_unref(holder);
+  g_list_store_insert(store, position, holder);
+
+  g_object_unref(holder);
+}
+
+template <typename Holder>
+void remove_row(GListStore* store, const uint& id) {
+  if (const auto [position, found] = find_row<Holder>(store, id); found) {
+    g_list_store_remove(store, position);
+  }
+}
+
+// The holder of the row with this id. It has to be unreferenced by the caller
+
+template <typename Holder>
+auto get_row(GListStore* store, const uint& id) -> Holder* {
+  const auto [position, found] = find_row<Holder>(store, id);
+
+  return (found) ? static_cast<Holder*>(g_list_model_get_item(G_LIST_MODEL(store), position)) : nullptr;
+}
+
+// The autoloading stores have the same rows as the device stores
+
+void add_device(GListStore* model, GListStore* autoloading_model, const NodeInfo& info) {
+  const auto [position, found] = find_row<ui::holders::NodeInfoHolder>(model, info.id);
+
+  if (found) {
+    return;
+  }
+
+  auto* holder = ui::holders::create(info);
+
+  g_list_store_insert(model, position, holder);
+  g_list_store_insert(autoloading_model, position, holder);
+
+  g_object_unref(holder);
+}
+
+void remove_device(GListStore* model, GListStore* autoloading_model, const NodeInfo& info) {
+  if (const auto [position, found] = find_row<ui::holders::NodeInfoHolder>(model, info.id); found) {
+    g_list_store_remove(model, position);
+    g_list_store_remove(autoloading_model, position);
+  }
+}
+
+void update_device(GListStore* model, const NodeInfo& info) {
+  auto* holder = get_row<ui::holders::NodeInfoHolder>(model, info.id);
+
+  if (holder == nullptr) {
+    return;
+  }
+
+  // The changed signals are also emitted for volume and state changes. Those do not touch the row
+
+  if (holder->info->description != info.description) {
+    g_object_set(holder, "description", info.description.c_str(), nullptr);
+  }
+
+  g_object_unref(holder);
+}
+
+void update_module(PipeManagerBox* self, const ModuleInfo& info) {
+  auto* holder = get_row<ui::holders::ModuleInfoHolder>(self->modules_model, info.id);
+
+  if (holder == nullptr) {
+    return;
+  }
+
+  if (holder->info->name != info.name) {
+    g_object_set(holder, "name", info.name.c_str(), nullptr);
+  }
+
+  if (holder->info->description != info.description) {
+    g_object_set(holder, "description", info.description.c_str(), nullptr);
+  }
+
+  if (holder->info->filename != info.filename) {
+    g_object_set(holder, "file-name", info.filename.c_str(), nullptr);
   }
+
+  g_object_unref(holder);
 }
 
-void on_stack_visible_child_changed(PipeManagerBox* self, GParamSpec* pspec, GtkWidget* stack) {
-  if (const auto* const name = gtk_stack_get_visible_child_name(GTK_STACK(stack));
-      g_strcmp0(name, "page_modules") == 0) {
-    update_modules_info(self);
-  } else if (g_strcmp0(name, "page_clients") == 0) {
-    update_clients_info(self);
+void update_client(PipeManagerBox* self, const ClientInfo& info) {
+  auto* holder = get_row<ui::holders::ClientInfoHolder>(self->clients_model, info.id);
+
+  if (holder == nullptr) {
+    return;
+  }
+
+  if (holder->info->name != info.name) {
+    g_object_set(holder, "name", info.name.c_str(), nullptr);
+  }
+
+  if (holder->info->api != info.api) {
+    g_object_set(holder, "api", info.api.c_str(), nullptr);
+  }
+
+  if (holder->info->access != info.access) {
+    g_object_set(holder, "access", info.access.c_str(), nullptr);
   }
+
+  g_object_unref(holder);
 }
 
 void setup_listview_modules(PipeManagerBox* self) {
@@ -429,6 +549,59 @@ void setup_dropdown_devices(PipeManagerBox* self, GtkDropDown* dropdown, GListSt
   g_object_unref(selection);
 }
 
+void update_compared_denoisers(PipeManagerBox* self, const std::vector<StreamInputEffects::DenoiserStats>& stats) {
+  std::vector<std::string> names;
+
+  guint monitored = GTK_INVALID_LIST_POSITION;
+
+  for (const auto& s : stats) {
+    if (s.monitored) {
+      monitored = static_cast<guint>(names.size());
+    }
+
+    names.push_back(s.name);
+  }
+
+  // the selection changes made here must not be written back to the settings
+
+  self->data->updating_compared_denoisers = true;
+
+  if (names != self->data->compared_denoisers) {
+    const auto& translated = tags::plugin_name::get_translated();
+
+    std::vector<std::string> labels;
+
+    for (const auto& name : names) {
+      const auto base_name = tags::plugin_name::get_base_name(name);
+
+      labels.push_back(translated.contains(base_name) ? translated.at(base_name) : base_name);
+    }
+
+    std::vector<const char*> items;
+
+    for (const auto& label : labels) {
+      items.push_back(label.c_str());
+    }
+
+    items.push_back(nullptr);
+
+    gtk_string_list_splice(self->compared_denoisers_string_list, 0,
+                           g_list_model_get_n_items(G_LIST_MODEL(self->compared_denoisers_string_list)),
+                           items.data());
+
+    self->data->compared_denoisers = names;
+  }
+
+  if (monitored != GTK_INVALID_LIST_POSITION &&
+      gtk_drop_down_get_selected(self->dropdown_compared_denoisers) != monitored) {
+    gtk_drop_down_set_selected(self->dropdown_compared_denoisers, monitored);
+  }
+
+  gtk_widget_set_sensitive(GTK_WIDGET(self->dropdown_compared_denoisers), names.empty() ? 0 : 1);
+
+  self->data->updating_compared_denoisers = false;
+}
+
 void setup(PipeManagerBox* self, app::Application* application) {
   self->data->application = application;
 
@@ -442,21 +615,19 @@ void setup(PipeManagerBox* self, app::Application* application) {
     }
 
     if (node.media_class == tags::pipewire::media_class::sink) {
-      auto* holder = ui::holders::create(node);
-
-      g_list_store_append(self->output_devices_model, holder);
-      g_list_store_append(self->autoloading_output_devices_model, holder);
-
-      g_object_unref(holder);
+      add_device(self->output_devices_model, self->autoloading_output_devices_model, node);
     } else if (node.media_class == tags::pipewire::media_class::source ||
                node.media_class == tags::pipewire::media_class::virtual_source) {
-      auto* holder = ui::holders::create(node);
+      add_device(self->input_devices_model, self->autoloading_input_devices_model, node);
+    }
+  }
 
-      g_list_store_append(self->input_devices_model, holder);
-      g_list_store_append(self->autoloading_input_devices_model, holder);
+  for (const auto& info : pm->list_modules) {
+    add_row<ui::holders::ModuleInfoHolder>(self->modules_model, info);
+  }
 
-      g_object_unref(holder);
-    }
+  for (const auto& info : pm->list_clients) {
+    add_row<ui::holders::ClientInfoHolder>(self->clients_model, info);
   }
 
   int rate = 0;
@@ -517,6 +688,27 @@ void setup(PipeManagerBox* self, app::Application* application) {
                    }),
                    self);
 
+  g_signal_connect(self->dropdown_compared_denoisers, "notify::selected",
+                   G_CALLBACK(+[](GtkDropDown* dropdown, GParamSpec* pspec, PipeManagerBox* self) {
+                     const auto n = gtk_drop_down_get_selected(dropdown);
+
+                     if (self->data->updating_compared_denoisers || n >= self->data->compared_denoisers.size()) {
+                       return;
+                     }
+
+                     const auto& name = self->data->compared_denoisers[n];
+
+                     if (util::gsettings_get_string(self->sie_settings, "denoiser-comparison-output") != name) {
+                       g_settings_set_string(self->sie_settings, "denoiser-comparison-output", name.c_str());
+                     }
+                   }),
+                   self);
+
+  // the denoisers being compared arrive with their statistics. They are emitted in the main thread
+
+  self->data->connections.push_back(application->sie->denoiser_stats.connect(
+      [=](const std::vector<StreamInputEffects::DenoiserStats>& stats) { update_compared_denoisers(self, stats); }));
+
   // initializing the custom device selection dropdowns to the previoulsly used device
 
   {
@@ -574,84 +766,46 @@ void setup(PipeManagerBox* self, app::Application* application) {
   // signals related to device insertion/removal
 
   self->data->connections.push_back(pm->sink_added.connect([=](const NodeInfo& info) {
-    for (guint n = 0U; n < g_list_model_get_n_items(G_LIST_MODEL(self->output_devices_model)); n++) {
-      auto* holder =
-          static_cast<ui::holders::NodeInfoHolder*>(g_list_model_get_item(G_LIST_MODEL(self->output_devices_model), n));
-
-      if (holder->info->id == info.id) {
-        g_object_unref(holder);
-
-        return;
-      }
-
-      g_object_unref(holder);
-    }
-
-    auto* holder = ui::holders::create(info);
-
-    g_list_store_append(self->output_devices_model, holder);
-    g_list_store_append(self->autoloading_output_devices_model, holder);
-
-    g_object_unref(holder);
+    add_device(self->output_devices_model, self->autoloading_output_devices_model, info);
   }));
 
   self->data->connections.push_back(pm->sink_removed.connect([=](const NodeInfo& info) {
-    for (guint n = 0U; n < g_list_model_get_n_items(G_LIST_MODEL(self->output_devices_model)); n++) {
-      auto* holder =
-          static_cast<ui::holders::NodeInfoHolder*>(g_list_model_get_item(G_LIST_MODEL(self->output_devices_model), n));
-
-      if (holder->info->id == info.id) {
-        g_list_store_remove(self->output_devices_model, n);
-        g_list_store_remove(self->autoloading_output_devices_model, n);
-
-        g_object_unref(holder);
-
-        return;
-      }
-
-      g_object_unref(holder);
-    }
+    remove_device(self->output_devices_model, self->autoloading_output_devices_model, info);
   }));
 
-  self->data->connections.push_back(pm->source_added.connect([=](const NodeInfo& info) {
-    for (guint n = 0U; n < g_list_model_get_n_items(G_LIST_MODEL(self->input_devices_model)); n++) {
-      auto* holder =
-          static_cast<ui::holders::NodeInfoHolder*>(g_list_model_get_item(G_LIST_MODEL(self->input_devices_model), n));
-
-      if (holder->info->id == info.id) {
-        g_object_unref(holder);
+  self->data->connections.push_back(
+      pm->sink_changed.connect([=](const NodeInfo& info) { update_device(self->output_devices_model, info); }));
 
-        return;
-      }
+  self->data->connections.push_back(pm->source_added.connect([=](const NodeInfo& info) {
+    add_device(self->input_devices_model, self->autoloading_input_devices_model, info);
+  }));
 
-      g_object_unref(holder);
-    }
+  self->data->connections.push_back(pm->source_removed.connect([=](const NodeInfo& info) {
+    remove_device(self->input_devices_model, self->autoloading_input_devices_model, info);
+  }));
 
-    auto* holder = ui::holders::create(info);
+  self->data->connections.push_back(
+      pm->source_changed.connect([=](const NodeInfo& info) { update_device(self->input_devices_model, info); }));
 
-    g_list_store_append(self->input_devices_model, holder);
-    g_list_store_append(self->autoloading_input_devices_model, holder);
+  // signals related to modules and clients
 
-    g_object_unref(holder);
-  }));
+  self->data->connections.push_back(pm->module_added.connect(
+      [=](const ModuleInfo& info) { add_row<ui::holders::ModuleInfoHolder>(self->modules_model, info); }));
 
-  self->data->connections.push_back(pm->source_removed.connect([=](const NodeInfo& info) {
-    for (guint n = 0U; n < g_list_model_get_n_items(G_LIST_MODEL(self->input_devices_model)); n++) {
-      auto* holder =
-          static_cast<ui::holders::NodeInfoHolder*>(g_list_model_get_item(G_LIST_MODEL(self->input_devices_model), n));
+  self->data->connections.push_back(pm->module_removed.connect(
+      [=](const uint id) { remove_row<ui::holders::ModuleInfoHolder>(self->modules_model, id); }));
 
-      if (holder->info->id == info.id) {
-        g_list_store_remove(self->input_devices_model, n);
-        g_list_store_remove(self->autoloading_input_devices_model, n);
+  self->data->connections.push_back(
+      pm->module_changed.connect([=](const ModuleInfo& info) { update_module(self, info); }));
 
-        g_object_unref(holder);
+  self->data->connections.push_back(pm->client_added.connect(
+      [=](const ClientInfo& info) { add_row<ui::holders::ClientInfoHolder>(self->clients_model, info); }));
 
-        return;
-      }
+  self->data->connections.push_back(pm->client_removed.connect(
+      [=](const uint id) { remove_row<ui::holders::ClientInfoHolder>(self->clients_model, id); }));
 
-      g_object_unref(holder);
-    }
-  }));
+  self->data->connections.push_back(
+      pm->client_changed.connect([=](const ClientInfo& info) { update_client(self, info); }));
 
   // updating the devices dropdown when the default device is changed
 
@@ -863,6 +1017,8 @@ void pipe_manager_box_class_init(PipeManagerBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, use_default_input);
   gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, use_default_output);
   gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, enable_test_signal);
+  gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, denoiser_comparison);
+  gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, ducking);
 
   gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, dropdown_input_devices);
   gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, dropdown_output_devices);
@@ -870,6 +1026,9 @@ void pipe_manager_box_class_init(PipeManagerBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, dropdown_autoloading_output_devices);
   gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, dropdown_autoloading_input_presets);
   gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, dropdown_autoloading_output_presets);
+  gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, dropdown_compared_denoisers);
+
+  gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, compared_denoisers_string_list);
 
   gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, listview_modules);
   gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, listview_clients);
@@ -887,6 +1046,9 @@ void pipe_manager_box_class_init(PipeManagerBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, server_rate);
 
   gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, spinbutton_test_signal_frequency);
+  gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, ducking_reduction);
+  gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, ducking_attack);
+  gtk_widget_class_bind_template_child(widget_class, PipeManagerBox, ducking_release);
 
   gtk_widget_class_bind_template_callback(widget_class, on_enable_test_signal);
   gtk_widget_class_bind_template_callback(widget_class, on_checkbutton_channel_left);
@@ -894,7 +1056,6 @@ void pipe_manager_box_class_init(PipeManagerBoxClass* klass) {
   gtk_widget_class_bind_template_callback(widget_class, on_checkbutton_channel_both);
   gtk_widget_class_bind_template_callback(widget_class, on_checkbutton_signal_sine);
   gtk_widget_class_bind_template_callback(widget_class, on_checkbutton_signal_gaussian);
-  gtk_widget_class_bind_template_callback(widget_class, on_stack_visible_child_changed);
   gtk_widget_class_bind_template_callback(widget_class, on_autoloading_add_input_profile);
   gtk_widget_class_bind_template_callback(widget_class, on_autoloading_add_output_profile);
 }
@@ -920,6 +1081,8 @@ void pipe_manager_box_init(PipeManagerBox* self) {
   self->soe_settings = g_settings_new(tags::schema::id_output);
 
   prepare_spinbuttons<"Hz">(self->spinbutton_test_signal_frequency);
+  prepare_spinbuttons<"dB">(self->ducking_reduction);
+  prepare_spinbuttons<"ms">(self->ducking_attack, self->ducking_release);
 
   g_settings_bind(self->sie_settings, "use-default-input-device", self->use_default_input, "active",
                   G_SETTINGS_BIND_DEFAULT);
@@ -927,6 +1090,12 @@ void pipe_manager_box_init(PipeManagerBox* self) {
   g_settings_bind(self->soe_settings, "use-default-output-device", self->use_default_output, "active",
                   G_SETTINGS_BIND_DEFAULT);
 
+  g_settings_bind(self->sie_settings, "denoiser-comparison", self->denoiser_comparison, "active",
+                  G_SETTINGS_BIND_DEFAULT);
+
+  gsettings_bind_widgets<"ducking", "ducking-reduction", "ducking-attack", "ducking-release">(
+      self->soe_settings, self->ducking, self->ducking_reduction, self->ducking_attack, self->ducking_release);
+
   g_signal_connect(self->spinbutton_test_signal_frequency, "value-changed",
                    G_CALLBACK(+[](GtkSpinButton* btn, PipeManagerBox* self) {
                      self->data->ts->set_frequency(static_cast<float>(gtk_spin_button_get_value(btn)));
@@ -432,3 +432,8 @@ void Pitch::init_soundtouch() {
 auto Pitch::get_latency_seconds() -> float {
   return latency_value;
 }
+
+auto Pitch::count_memory_usage() -> size_t {
+  return PluginBase::count_memory_usage() + util::container_bytes(data_L) + util::container_bytes(data_R) +
+         util::container_bytes(data) + util::container_bytes(deque_out_L) + util::container_bytes(deque_out_R);
+}
@@ -27,6 +27,7 @@
 #include <pipewire/loop.h>
 #include <pipewire/port.h>
 #include <pipewire/properties.h>
+#include <pipewire/proxy.h>
 #include <pipewire/thread-loop.h>
 #include <spa/node/io.h>
 #include <spa/param/latency-utils.h>
@@ -36,19 +37,30 @@
 #include <spa/pod/pod.h>
 #include <spa/support/loop.h>
 #include <spa/utils/defs.h>
+#include <spa/utils/dict.h>
 #include <spa/utils/hook.h>
 #include <sys/types.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <numbers>
 #include <span>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
+#include "analyzer_taps.hpp"
+#include "meters_export.hpp"
 #include "pipe_manager.hpp"
+#include "rt_checks.hpp"
 #include "tags_app.hpp"
+#include "tags_pipewire.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
 
@@ -57,6 +69,8 @@ namespace {
 void on_process(void* userdata, spa_io_position* position) {
   auto* d = static_cast<PluginBase::data*>(userdata);
 
+  const rt_checks::Scope rt_scope(d->pb->name.c_str());
+
   const auto n_samples = position->clock.duration;
   const auto rate = position->clock.rate.denom;
 
@@ -87,6 +101,10 @@ void on_process(void* userdata, spa_io_position* position) {
 
   // util::warning("processing: " + util::to_string(n_samples));
 
+  // the parameters changed by the main thread are picked only here so they are constant during the quantum
+
+  d->pb->acquire_common_params();
+
   auto* in_left = static_cast<float*>(pw_filter_get_dsp_buffer(d->in_left, n_samples));
   auto* in_right = static_cast<float*>(pw_filter_get_dsp_buffer(d->in_right, n_samples));
 
@@ -122,6 +140,8 @@ void on_process(void* userdata, spa_io_position* position) {
     right_out = d->pb->dummy_right;
   }
 
+  const auto process_start = std::chrono::steady_clock::now();
+
   if (!d->pb->enable_probe) {
     d->pb->process(left_in, right_in, left_out, right_out);
   } else {
@@ -141,7 +161,33 @@ void on_process(void* userdata, spa_io_position* position) {
     }
   }
 
+  d->pb->process_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - process_start).count();
+
+  d->pb->audio_seconds += static_cast<double>(n_samples) / static_cast<double>(rate);
+
+  if (d->pb->output_muted.load(std::memory_order_relaxed)) {
+    std::ranges::fill(left_out, 0.0F);
+    std::ranges::fill(right_out, 0.0F);
+  }
+
+  d->pb->apply_fade(left_out, right_out);
+
+  if (auto* tap = d->pb->analyzer_tap.load(std::memory_order_acquire); tap != nullptr) {
+    tap->rate.store(rate, std::memory_order_relaxed);
+
+    if (d->pb->analyzer_tap_point.load(std::memory_order_relaxed) == TapPoint::input) {
+      tap->write(left_in, right_in);
+    } else {
+      tap->write(left_out, right_out);
+    }
+  }
+
   if (d->pb->send_notifications) {
+    d->pb->dsp_load.store(static_cast<float>(d->pb->process_seconds / d->pb->audio_seconds), std::memory_order_relaxed);
+
+    d->pb->process_seconds = 0.0;
+    d->pb->audio_seconds = 0.0;
+
     d->pb->clock_start = std::chrono::system_clock::now();
 
     d->pb->send_notifications = false;
@@ -218,15 +264,19 @@ PluginBase::PluginBase(std::string tag,
   std::string description;
 
   if (name != "output_level" && name != "spectrum") {
-    description = tags::plugin_name::get_translated()[name];
+    if (const auto& translated = tags::plugin_name::get_translated(); translated.contains(name)) {
+      description = translated.at(name);
+    }
 
-    bypass = g_settings_get_boolean(settings, "bypass") != 0;
+    set_bypass(g_settings_get_boolean(settings, "bypass") != 0);
 
     gconnections.push_back(g_signal_connect(settings, "changed::bypass",
                                             G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                                               auto* self = static_cast<PluginBase*>(user_data);
 
-                                              self->bypass = g_settings_get_boolean(settings, "bypass") != 0;
+                                              self->set_bypass(g_settings_get_boolean(settings, "bypass") != 0);
+
+                                              self->bypass_changed.emit(self->get_bypass());
                                             }),
                                             this));
   } else if (name == "output_level") {
@@ -237,7 +287,40 @@ PluginBase::PluginBase(std::string tag,
 
   pf_data.pb = this;
 
-  const auto filter_name = "ee_" + log_tag.substr(0U, log_tag.size() - 2U) + "_" + name;
+  // The spectrum has no level meters. Its magnitudes go to the spectrum area of its pipeline. See Spectrum::process
+
+  if (meters_export != nullptr && name != "spectrum") {
+    // The last element of the schema path is the instance id of the plugin. The level meters do not have one.
+
+    auto label = name;
+
+    const auto path = std::filesystem::path(schema_path).parent_path();
+
+    if (uint id = 0U; util::str_to_num(path.filename().string(), id)) {
+      label += "#" + util::to_string(id);
+    }
+
+    /*
+      The application chains and the preset stage have plugins with the same names as the main pipeline. Their labels
+      start with the path of their chain, like appchains/firefox/compressor#0
+    */
+
+    for (const std::string base : {tags::app::path_app_chains, tags::app::path_preset_stage}) {
+      if (schema_path.starts_with(base)) {
+        const auto start = std::string(tags::app::path).size() + 1U;
+
+        label = schema_path.substr(start, schema_path.find('/', base.size()) - start) + "/" + label;
+
+        break;
+      }
+    }
+
+    meters_slot = meters_export->acquire_slot(pipeline_type, label);
+
+    set_export_meters(g_settings_get_boolean(global_settings, "export-meters") != 0);
+  }
+
+  filter_name = "ee_" + log_tag.substr(0U, log_tag.size() - 2U) + "_" + name;
 
   pm->lock();
 
@@ -346,18 +429,74 @@ PluginBase::~PluginBase() {
 
   gconnections.clear();
 
+  if (meters_export != nullptr) {
+    meters_export->release_slot(meters_slot);
+  }
+
   g_object_unref(settings);
 }
 
 void PluginBase::set_post_messages(const bool& state) {
-  post_messages = state;
+  post_messages_ui = state;
+
+  post_messages = post_messages_ui || export_meters;
+}
+
+void PluginBase::set_export_meters(const bool& state) {
+  /*
+    The level meters are only measured while post_messages is true. When they are exported we have to measure them
+    even if no window is showing this plugin.
+  */
+
+  export_meters = state && meters_export != nullptr && meters_slot >= 0;
+
+  post_messages = post_messages_ui || export_meters;
+}
+
+void PluginBase::set_analyzer_tap(AnalyzerTap* tap, const TapPoint& point) {
+  analyzer_tap_point.store(point, std::memory_order_relaxed);
+
+  analyzer_tap.store(tap, std::memory_order_release);
 }
 
 void PluginBase::reset_settings() {
   util::reset_all_keys_except(settings);
 }
 
+void PluginBase::expose_as_virtual_source() {
+  /*
+    A source must not be passive or recording apps would not keep it running. A null value removes the key, so the
+    session manager does not handle the node as a filter anymore.
+  */
+
+  const auto items = std::to_array<spa_dict_item>(
+      {SPA_DICT_ITEM_INIT(PW_KEY_NODE_NAME, tags::pipewire::ee_source_name),
+       SPA_DICT_ITEM_INIT(PW_KEY_NODE_DESCRIPTION, "Easy Effects Source"),
+       SPA_DICT_ITEM_INIT(PW_KEY_NODE_VIRTUAL, "true"),
+       SPA_DICT_ITEM_INIT(PW_KEY_NODE_PASSIVE, "false"),
+       SPA_DICT_ITEM_INIT(PW_KEY_MEDIA_CLASS, tags::pipewire::media_class::virtual_source),
+       SPA_DICT_ITEM_INIT(PW_KEY_MEDIA_CATEGORY, nullptr),
+       SPA_DICT_ITEM_INIT(PW_KEY_MEDIA_ROLE, nullptr),
+       SPA_DICT_ITEM_INIT(PW_KEY_PRIORITY_SESSION, "0")});
+
+  const auto dict = SPA_DICT_INIT(items.data(), static_cast<uint32_t>(items.size()));
+
+  pm->lock();
+
+  pw_filter_update_properties(filter, nullptr, &dict);
+
+  pm->unlock();
+}
+
 auto PluginBase::connect_to_pw() -> bool {
+  if (!connecting_to_pw && !start_pw_connection()) {
+    return false;
+  }
+
+  return finish_pw_connection();
+}
+
+auto PluginBase::start_pw_connection() -> bool {
   connected_to_pw = false;
   can_get_node_id = false;
   state = PW_FILTER_STATE_UNCONNECTED;
@@ -374,9 +513,21 @@ auto PluginBase::connect_to_pw() -> bool {
 
   initialize_listener();
 
+  connecting_to_pw = true;
+
+  pm->unlock();
+
+  return true;
+}
+
+auto PluginBase::finish_pw_connection() -> bool {
+  connecting_to_pw = false;
+
+  pm->lock();
+
   pm->sync_wait_unlock();
 
-  while (!can_get_node_id) {
+  for (int timeout = 0; !can_get_node_id; timeout++) {
     std::this_thread::sleep_for(std::chrono::milliseconds(1));
 
     if (state == PW_FILTER_STATE_ERROR) {
@@ -384,6 +535,12 @@ auto PluginBase::connect_to_pw() -> bool {
 
       return false;
     }
+
+    if (timeout > 10000) {  // 10 seconds
+      util::warning(log_tag + name + " is taking too long to get a node id");
+
+      return false;
+    }
   }
 
   pm->lock();
@@ -392,13 +549,21 @@ auto PluginBase::connect_to_pw() -> bool {
 
   pm->sync_wait_unlock();
 
+  pm->filter_nodes.insert_or_assign(filter_name, node_id);
+
   /*
     The filter we link in our pipeline have at least 4 ports. Some have six. Before we try to link filters we have to
     wait until the information about their ports is available in PipeManager's list_ports vector.
   */
 
-  while (pm->count_node_ports(node_id) != n_ports) {
+  for (int timeout = 0; pm->count_node_ports(node_id) != n_ports; timeout++) {
     std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    if (timeout > 10000) {  // 10 seconds
+      util::warning(log_tag + name + " ports are taking too long to be available");
+
+      return false;
+    }
   }
 
   connected_to_pw = true;
@@ -433,9 +598,12 @@ void PluginBase::disconnect_from_pw() {
   pw_filter_disconnect(filter);
 
   connected_to_pw = false;
+  connecting_to_pw = false;
 
   pm->sync_wait_unlock();
 
+  pm->filter_nodes.erase(filter_name);
+
   node_id = SPA_ID_INVALID;
 }
 
@@ -457,6 +625,173 @@ auto PluginBase::get_latency_seconds() -> float {
   return 0.0F;
 }
 
+auto PluginBase::get_lookahead_ms() -> double {
+  return lookahead_ports ? g_settings_get_double(settings, lookahead_ports->lookahead_key.c_str()) : 0.0;
+}
+
+auto PluginBase::can_read_ahead() -> bool {
+  if (!lookahead_ports || lookahead_ports->sidechain_key.empty()) {
+    return false;
+  }
+
+  return util::gsettings_get_string(settings, lookahead_ports->sidechain_key) == lookahead_ports->read_ahead_value;
+}
+
+void PluginBase::set_shared_lookahead(const double& lookahead_ms, const uint& source_node_id) {
+  if (lookahead_ms == shared_lookahead_ms && source_node_id == shared_lookahead_source_id) {
+    return;
+  }
+
+  shared_lookahead_ms = lookahead_ms;
+  shared_lookahead_source_id = source_node_id;
+
+  apply_shared_lookahead();
+
+  util::debug(log_tag + name + " shared lookahead: " + util::to_string(lookahead_ms, "") + " ms" +
+              ((source_node_id != SPA_ID_INVALID) ? ", reading ahead from node " + util::to_string(source_node_id)
+                                                  : ""));
+}
+
+auto PluginBase::uses_shared_lookahead() -> bool {
+  return shared_lookahead_ms > 0.0 && (lv2_wrapper == nullptr || !lv2_wrapper->has_ui());
+}
+
+auto PluginBase::reads_ahead() -> bool {
+  return uses_shared_lookahead() && shared_lookahead_source_id != SPA_ID_INVALID;
+}
+
+auto PluginBase::link_read_ahead_source() -> std::vector<pw_proxy*> {
+  auto links = pm->link_nodes(shared_lookahead_source_id, get_node_id(), true);
+
+  // the microphone may have a single channel
+
+  if (links.size() != 2U) {
+    util::warning(log_tag + name + " could not link its probe to node " + util::to_string(shared_lookahead_source_id) +
+                  ". It will use its own lookahead");
+
+    pm->destroy_links(links);
+
+    links.clear();
+
+    shared_lookahead_ms = 0.0;
+    shared_lookahead_source_id = SPA_ID_INVALID;
+  }
+
+  return links;
+}
+
+void PluginBase::setup_shared_lookahead(const LookaheadPorts& ports) {
+  lookahead_ports = ports;
+
+  std::vector<std::string> keys = {ports.lookahead_key};
+
+  if (!ports.sidechain_key.empty()) {
+    keys.push_back(ports.sidechain_key);
+  }
+
+  /*
+    The links only depend on the shared lookahead and on the sidechain settings the subclasses already follow. If
+    these keys change what the plugin can read ahead EffectsBase::update_shared_lookahead relinks it.
+  */
+
+  for (const auto& key : keys) {
+    gconnections.push_back(g_signal_connect(settings, ("changed::" + key).c_str(),
+                                            G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                              auto* self = static_cast<PluginBase*>(user_data);
+
+                                              self->write_lookahead_ports();
+
+                                              self->lookahead_changed.emit();
+                                            }),
+                                            this));
+  }
+
+  if (!ports.preamp_key.empty()) {
+    for (const auto& key : {ports.preamp_key, std::string("input-gain")}) {
+      gconnections.push_back(g_signal_connect(settings, ("changed::" + key).c_str(),
+                                              G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                                auto* self = static_cast<PluginBase*>(user_data);
+
+                                                self->write_sidechain_preamp();
+                                              }),
+                                              this));
+    }
+  }
+}
+
+void PluginBase::apply_shared_lookahead() {
+  if (!lookahead_ports || !package_installed) {
+    return;
+  }
+
+  // the links come first because a failure makes the plugin go back to its own lookahead
+
+  if (!lookahead_ports->sidechain_key.empty()) {
+    update_probe_links();
+  }
+
+  write_lookahead_ports();
+}
+
+void PluginBase::write_lookahead_ports() {
+  if (!lookahead_ports || !package_installed) {
+    return;
+  }
+
+  const auto& ports = *lookahead_ports;
+
+  auto lookahead = g_settings_get_double(settings, ports.lookahead_key.c_str());
+
+  const auto reading = !ports.sidechain_key.empty() && reads_ahead();
+
+  if (reading) {
+    lookahead = 0.0;
+  } else if (uses_shared_lookahead()) {
+    lookahead = std::max(lookahead, shared_lookahead_ms);
+  }
+
+  lv2_wrapper->set_control_port_value(ports.lookahead_port, static_cast<float>(lookahead));
+
+  if (!ports.sidechain_key.empty()) {
+    const auto sidechain =
+        reading ? ports.external_sidechain : g_settings_get_enum(settings, ports.sidechain_key.c_str());
+
+    lv2_wrapper->set_control_port_value(ports.sidechain_port, static_cast<float>(sidechain));
+  }
+
+  write_sidechain_preamp();
+}
+
+void PluginBase::write_sidechain_preamp() {
+  if (!lookahead_ports || !package_installed || lookahead_ports->preamp_key.empty()) {
+    return;
+  }
+
+  auto preamp = g_settings_get_double(settings, lookahead_ports->preamp_key.c_str());
+
+  if (!lookahead_ports->sidechain_key.empty() && reads_ahead()) {
+    preamp += g_settings_get_double(settings, "input-gain");
+  }
+
+  lv2_wrapper->set_control_port_value(lookahead_ports->preamp_port, static_cast<float>(util::db_to_linear(preamp)));
+}
+
+auto PluginBase::get_memory_usage() -> size_t {
+  std::unique_lock<std::mutex> lock(data_mutex, std::try_to_lock);
+
+  if (lock.owns_lock()) {
+    memory_usage = count_memory_usage();
+  }
+
+  return memory_usage;
+}
+
+auto PluginBase::count_memory_usage() -> size_t {
+  return util::container_bytes(dummy_left) + util::container_bytes(dummy_right);
+}
+
+void PluginBase::release_caches() {}
+
 void PluginBase::show_native_ui() {
   if (lv2_wrapper == nullptr) {
     return;
@@ -464,6 +799,8 @@ void PluginBase::show_native_ui() {
 
   if (!lv2_wrapper->has_ui()) {
     lv2_wrapper->load_ui();
+
+    apply_shared_lookahead();
   }
 }
 
@@ -474,6 +811,8 @@ void PluginBase::close_native_ui() {
 
   lv2_wrapper->native_ui_to_gsettings();
   lv2_wrapper->close_ui();
+
+  apply_shared_lookahead();
 }
 
 void PluginBase::set_native_ui_update_frequency(const uint& value) {
@@ -510,13 +849,17 @@ void PluginBase::get_peaks(const std::span<float>& left_in,
 }
 
 void PluginBase::setup_input_output_gain() {
-  input_gain = static_cast<float>(util::db_to_linear(g_settings_get_double(settings, "input-gain")));
-  output_gain = static_cast<float>(util::db_to_linear(g_settings_get_double(settings, "output-gain")));
+  common_params.update([this](CommonParams& p) {
+    p.input_gain = static_cast<float>(util::db_to_linear(g_settings_get_double(settings, "input-gain")));
+    p.output_gain = static_cast<float>(util::db_to_linear(g_settings_get_double(settings, "output-gain")));
+  });
 
   g_signal_connect(settings, "changed::input-gain", G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                      auto* self = static_cast<PluginBase*>(user_data);
 
-                     self->input_gain = util::db_to_linear(g_settings_get_double(settings, key));
+                     const auto v = static_cast<float>(util::db_to_linear(g_settings_get_double(settings, key)));
+
+                     self->common_params.update([&](CommonParams& p) { p.input_gain = v; });
                    }),
                    this);
 
@@ -524,11 +867,63 @@ void PluginBase::setup_input_output_gain() {
                    G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                      auto* self = static_cast<PluginBase*>(user_data);
 
-                     self->output_gain = util::db_to_linear(g_settings_get_double(settings, key));
+                     const auto v = static_cast<float>(util::db_to_linear(g_settings_get_double(settings, key)));
+
+                     self->common_params.update([&](CommonParams& p) { p.output_gain = v; });
                    }),
                    this);
 }
 
+void PluginBase::set_bypass(const bool& state) {
+  common_params.update([&](CommonParams& p) { p.bypass = state; });
+}
+
+void PluginBase::fade_to(const float& target, const float& seconds, const FadeLaw& law) {
+  fade_params.update([&](Fade& f) {
+    f.target = std::clamp(target, 0.0F, 1.0F);
+    f.seconds = std::max(seconds, 0.0F);
+    f.law = law;
+  });
+}
+
+void PluginBase::apply_fade(std::span<float>& left, std::span<float>& right) {
+  const auto& fade = fade_params.acquire();
+
+  if (fade_position == fade.target) {
+    if (fade_position == 0.0F) {
+      std::ranges::fill(left, 0.0F);
+      std::ranges::fill(right, 0.0F);
+    }
+
+    return;
+  }
+
+  const auto step = (fade.seconds > 0.0F && rate != 0U) ? 1.0F / (fade.seconds * static_cast<float>(rate)) : 1.0F;
+
+  for (size_t n = 0U; n < left.size(); n++) {
+    fade_position = (fade_position < fade.target) ? std::min(fade_position + step, fade.target)
+                                                  : std::max(fade_position - step, fade.target);
+
+    const auto gain = (fade.law == FadeLaw::linear) ? fade_position
+                                                    : std::sin(0.5F * std::numbers::pi_v<float> * fade_position);
+
+    left[n] *= gain;
+    right[n] *= gain;
+  }
+}
+
+auto PluginBase::get_bypass() const -> bool {
+  return common_params.written().bypass;
+}
+
+void PluginBase::acquire_common_params() {
+  const auto& common = common_params.acquire();
+
+  bypass = common.bypass;
+  input_gain = common.input_gain;
+  output_gain = common.output_gain;
+}
+
 void PluginBase::apply_gain(std::span<float>& left, std::span<float>& right, const float& gain) {
   if (left.empty() || right.empty()) {
     return;
@@ -548,6 +943,11 @@ void PluginBase::notify() {
   input_level.emit(input_peak_db_l, input_peak_db_r);
   output_level.emit(output_peak_db_l, output_peak_db_r);
 
+  if (export_meters) {
+    meters_export->publish_levels(meters_slot, input_peak_db_l, input_peak_db_r, output_peak_db_l, output_peak_db_r,
+                                  std::span<const float>(meter_values.data(), n_meter_values));
+  }
+
   input_peak_left = util::minimum_linear_level;
   input_peak_right = util::minimum_linear_level;
   output_peak_left = util::minimum_linear_level;
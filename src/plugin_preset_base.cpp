@@ -20,7 +20,10 @@
 #include "plugin_preset_base.hpp"
 #include <gio/gio.h>
 #include <glib-object.h>
+#include <glib.h>
+#include <string>
 #include "preset_type.hpp"
+#include "tags_app.hpp"
 #include "util.hpp"
 
 PluginPresetBase::PluginPresetBase(const char* schema_id,
@@ -46,3 +49,36 @@ PluginPresetBase::PluginPresetBase(const char* schema_id,
 PluginPresetBase::~PluginPresetBase() {
   g_object_unref(settings);
 }
+
+void PluginPresetBase::relocate(const std::string& base_path) {
+  auto* relocated = relocated_settings(settings, base_path);
+
+  g_object_unref(settings);
+
+  settings = relocated;
+}
+
+auto PluginPresetBase::relocated_settings(GSettings* source, const std::string& base_path) const -> GSettings* {
+  gchar* path = nullptr;
+
+  GSettingsSchema* schema = nullptr;
+
+  g_object_get(source, "path", &path, "settings-schema", &schema, nullptr);
+
+  const std::string pipeline_path =
+      (preset_type == PresetType::input) ? tags::app::path_stream_inputs : tags::app::path_stream_outputs;
+
+  std::string new_path = path;
+
+  if (new_path.starts_with(pipeline_path)) {
+    new_path.replace(0U, pipeline_path.size(), base_path);
+  }
+
+  auto* relocated = g_settings_new_full(schema, nullptr, new_path.c_str());
+
+  g_settings_schema_unref(schema);
+
+  g_free(path);
+
+  return relocated;
+}
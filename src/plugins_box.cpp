@@ -125,6 +125,8 @@ struct Data {
   std::vector<sigc::connection> connections;
 
   std::vector<gulong> gconnections;
+
+  std::vector<GtkToggleButton*> tap_buttons;
 };
 
 struct _PluginsBox {
@@ -160,6 +162,8 @@ G_DEFINE_TYPE(PluginsBox, plugins_box, GTK_TYPE_BOX)
 
 template <PipelineType pipeline_type>
 void add_plugins_to_stack(PluginsBox* self) {
+  using Type = tags::plugin_name::Type;
+
   EffectsBase* effects_base = nullptr;
 
   if constexpr (pipeline_type == PipelineType::input) {
@@ -192,353 +196,483 @@ void add_plugins_to_stack(PluginsBox* self) {
   auto plugins_list = util::gchar_array_to_vector(g_settings_get_strv(self->settings, "plugins"));
 
   for (const auto& name : plugins_list) {
-    auto path = self->data->schema_path + tags::plugin_name::get_base_name(name) + "/" +
+    const auto* descriptor = tags::plugin_name::find(name);
+
+    if (descriptor == nullptr) {
+      continue;
+    }
+
+    auto path = self->data->schema_path + descriptor->base_name + "/" +
                 util::to_string(tags::plugin_name::get_id(name)) + "/";
 
     path.erase(std::remove(path.begin(), path.end(), '_'), path.end());
 
-    if (name.starts_with(tags::plugin_name::autogain)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<AutoGain>(name);
+    switch (descriptor->type) {
+      case Type::autogain: {
+        auto plugin_ptr = effects_base->get_plugin_instance<AutoGain>(name);
 
-      auto* box = ui::autogain_box::create();
+        auto* box = ui::autogain_box::create();
 
-      ui::autogain_box::setup(box, plugin_ptr, path);
+        ui::autogain_box::setup(box, plugin_ptr, path);
 
-      gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::bass_enhancer)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<BassEnhancer>(name);
+        gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::bass_enhancer_box::create();
+        break;
+      }
+      case Type::bass_enhancer: {
+        GtkWidget* box = nullptr;
 
-        ui::bass_enhancer_box::setup(plugin_box, plugin_ptr, path);
+        auto plugin_ptr = effects_base->get_plugin_instance<BassEnhancer>(name);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::bass_enhancer_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::bass_loudness)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<BassLoudness>(name);
+          ui::bass_enhancer_box::setup(plugin_box, plugin_ptr, path);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::bass_loudness_box::create();
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
 
-        ui::bass_loudness_box::setup(plugin_box, plugin_ptr, path);
+        gtk_stack_add_named(self->stack, box, name.c_str());
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        break;
       }
+      case Type::bass_loudness: {
+        GtkWidget* box = nullptr;
+
+        auto plugin_ptr = effects_base->get_plugin_instance<BassLoudness>(name);
+
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::bass_loudness_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::compressor)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Compressor>(name);
+          ui::bass_loudness_box::setup(plugin_box, plugin_ptr, path);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::compressor_box::create();
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
 
-        ui::compressor_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
+        gtk_stack_add_named(self->stack, box, name.c_str());
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        break;
       }
+      case Type::compressor: {
+        GtkWidget* box = nullptr;
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (name.starts_with(tags::plugin_name::convolver)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Convolver>(name);
+        auto plugin_ptr = effects_base->get_plugin_instance<Compressor>(name);
 
-      auto* box = ui::convolver_box::create();
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::compressor_box::create();
 
-      ui::convolver_box::setup(box, plugin_ptr, path, self->data->application);
+          ui::compressor_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
 
-      gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
-    } else if (name.starts_with(tags::plugin_name::crossfeed)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Crossfeed>(name);
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
 
-      auto* box = ui::crossfeed_box::create();
+        gtk_stack_add_named(self->stack, box, name.c_str());
 
-      ui::crossfeed_box::setup(box, plugin_ptr, path);
+        break;
+      }
+      case Type::convolver: {
+        auto plugin_ptr = effects_base->get_plugin_instance<Convolver>(name);
+
+        auto* box = ui::convolver_box::create();
 
-      gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
-    } else if (name.starts_with(tags::plugin_name::crystalizer)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Crystalizer>(name);
+        ui::convolver_box::setup(box, plugin_ptr, path, self->data->application);
 
-      auto* box = ui::crystalizer_box::create();
+        gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
 
-      ui::crystalizer_box::setup(box, plugin_ptr, path);
+        break;
+      }
+      case Type::crossfeed: {
+        auto plugin_ptr = effects_base->get_plugin_instance<Crossfeed>(name);
 
-      gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::deepfilternet)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<DeepFilterNet>(name);
+        auto* box = ui::crossfeed_box::create();
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::deepfilternet_box::create();
+        ui::crossfeed_box::setup(box, plugin_ptr, path);
 
-        ui::deepfilternet_box::setup(plugin_box, plugin_ptr, path);
+        gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        break;
       }
+      case Type::crystalizer: {
+        auto plugin_ptr = effects_base->get_plugin_instance<Crystalizer>(name);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::deesser)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Deesser>(name);
+        auto* box = ui::crystalizer_box::create();
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::deesser_box::create();
+        ui::crystalizer_box::setup(box, plugin_ptr, path);
 
-        ui::deesser_box::setup(plugin_box, plugin_ptr, path);
+        gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        break;
       }
+      case Type::deepfilternet: {
+        GtkWidget* box = nullptr;
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::delay)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Delay>(name);
+        auto plugin_ptr = effects_base->get_plugin_instance<DeepFilterNet>(name);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::delay_box::create();
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::deepfilternet_box::create();
 
-        ui::delay_box::setup(plugin_box, plugin_ptr, path);
+          ui::deepfilternet_box::setup(plugin_box, plugin_ptr, path);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
+
+        gtk_stack_add_named(self->stack, box, name.c_str());
+
+        break;
       }
+      case Type::deesser: {
+        GtkWidget* box = nullptr;
+
+        auto plugin_ptr = effects_base->get_plugin_instance<Deesser>(name);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (name.starts_with(tags::plugin_name::echo_canceller)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<EchoCanceller>(name);
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::deesser_box::create();
 
-      auto* box = ui::echo_canceller_box::create();
+          ui::deesser_box::setup(plugin_box, plugin_ptr, path);
 
-      ui::echo_canceller_box::setup(box, plugin_ptr, path);
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
+
+        gtk_stack_add_named(self->stack, box, name.c_str());
+
+        break;
+      }
+      case Type::delay: {
+        GtkWidget* box = nullptr;
 
-      gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::exciter)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Exciter>(name);
+        auto plugin_ptr = effects_base->get_plugin_instance<Delay>(name);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::exciter_box::create();
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::delay_box::create();
 
-        ui::exciter_box::setup(plugin_box, plugin_ptr, path);
+          ui::delay_box::setup(plugin_box, plugin_ptr, path);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
+
+        gtk_stack_add_named(self->stack, box, name.c_str());
+
+        break;
       }
+      case Type::echo_canceller: {
+        auto plugin_ptr = effects_base->get_plugin_instance<EchoCanceller>(name);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::expander)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Expander>(name);
+        auto* box = ui::echo_canceller_box::create();
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::expander_box::create();
+        ui::echo_canceller_box::setup(box, plugin_ptr, path);
 
-        ui::expander_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
+        gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        break;
       }
+      case Type::equalizer: {
+        GtkWidget* box = nullptr;
+
+        auto plugin_ptr = effects_base->get_plugin_instance<Equalizer>(name);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::equalizer)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Equalizer>(name);
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::equalizer_box::create();
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::equalizer_box::create();
+          ui::equalizer_box::setup(plugin_box, plugin_ptr, path, self->data->application);
 
-        ui::equalizer_box::setup(plugin_box, plugin_ptr, path, self->data->application);
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        gtk_stack_add_named(self->stack, box, name.c_str());
+
+        break;
       }
+      case Type::exciter: {
+        GtkWidget* box = nullptr;
+
+        auto plugin_ptr = effects_base->get_plugin_instance<Exciter>(name);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::filter)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Filter>(name);
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::exciter_box::create();
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::filter_box::create();
+          ui::exciter_box::setup(plugin_box, plugin_ptr, path);
 
-        ui::filter_box::setup(plugin_box, plugin_ptr, path);
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        gtk_stack_add_named(self->stack, box, name.c_str());
+
+        break;
       }
+      case Type::expander: {
+        GtkWidget* box = nullptr;
+
+        auto plugin_ptr = effects_base->get_plugin_instance<Expander>(name);
+
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::expander_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::gate)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Gate>(name);
+          ui::expander_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::gate_box::create();
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
 
-        ui::gate_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
+        gtk_stack_add_named(self->stack, box, name.c_str());
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        break;
       }
+      case Type::filter: {
+        GtkWidget* box = nullptr;
+
+        auto plugin_ptr = effects_base->get_plugin_instance<Filter>(name);
+
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::filter_box::create();
+
+          ui::filter_box::setup(plugin_box, plugin_ptr, path);
+
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
+
+        gtk_stack_add_named(self->stack, box, name.c_str());
+
+        break;
+      }
+      case Type::gate: {
+        GtkWidget* box = nullptr;
+
+        auto plugin_ptr = effects_base->get_plugin_instance<Gate>(name);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::level_meter)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<LevelMeter>(name);
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::gate_box::create();
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::level_meter_box::create();
+          ui::gate_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
 
-        ui::level_meter_box::setup(plugin_box, plugin_ptr, path);
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        gtk_stack_add_named(self->stack, box, name.c_str());
+
+        break;
       }
+      case Type::level_meter: {
+        GtkWidget* box = nullptr;
+
+        auto plugin_ptr = effects_base->get_plugin_instance<LevelMeter>(name);
+
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::level_meter_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::limiter)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Limiter>(name);
+          ui::level_meter_box::setup(plugin_box, plugin_ptr, path);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::limiter_box::create();
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
 
-        ui::limiter_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
+        gtk_stack_add_named(self->stack, box, name.c_str());
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        break;
       }
+      case Type::limiter: {
+        GtkWidget* box = nullptr;
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::loudness)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Loudness>(name);
+        auto plugin_ptr = effects_base->get_plugin_instance<Limiter>(name);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::loudness_box::create();
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::limiter_box::create();
 
-        ui::loudness_box::setup(plugin_box, plugin_ptr, path);
+          ui::limiter_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
+
+        gtk_stack_add_named(self->stack, box, name.c_str());
+
+        break;
       }
+      case Type::loudness: {
+        GtkWidget* box = nullptr;
+
+        auto plugin_ptr = effects_base->get_plugin_instance<Loudness>(name);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::maximizer)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Maximizer>(name);
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::loudness_box::create();
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::maximizer_box::create();
+          ui::loudness_box::setup(plugin_box, plugin_ptr, path);
 
-        ui::maximizer_box::setup(plugin_box, plugin_ptr, path);
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        gtk_stack_add_named(self->stack, box, name.c_str());
+
+        break;
       }
+      case Type::maximizer: {
+        GtkWidget* box = nullptr;
+
+        auto plugin_ptr = effects_base->get_plugin_instance<Maximizer>(name);
+
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::maximizer_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::multiband_compressor)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<MultibandCompressor>(name);
+          ui::maximizer_box::setup(plugin_box, plugin_ptr, path);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::multiband_compressor_box::create();
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
 
-        ui::multiband_compressor_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
+        gtk_stack_add_named(self->stack, box, name.c_str());
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        break;
       }
+      case Type::multiband_compressor: {
+        GtkWidget* box = nullptr;
+
+        auto plugin_ptr = effects_base->get_plugin_instance<MultibandCompressor>(name);
+
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::multiband_compressor_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::multiband_gate)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<MultibandGate>(name);
+          ui::multiband_compressor_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::multiband_gate_box::create();
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
 
-        ui::multiband_gate_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
+        gtk_stack_add_named(self->stack, box, name.c_str());
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        break;
       }
+      case Type::multiband_gate: {
+        GtkWidget* box = nullptr;
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (name.starts_with(tags::plugin_name::pitch)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Pitch>(name);
+        auto plugin_ptr = effects_base->get_plugin_instance<MultibandGate>(name);
 
-      auto* box = ui::pitch_box::create();
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::multiband_gate_box::create();
 
-      ui::pitch_box::setup(box, plugin_ptr, path);
+          ui::multiband_gate_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
 
-      gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::reverb)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Reverb>(name);
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::reverb_box::create();
+        gtk_stack_add_named(self->stack, box, name.c_str());
 
-        ui::reverb_box::setup(plugin_box, plugin_ptr, path);
+        break;
+      }
+      case Type::pitch: {
+        auto plugin_ptr = effects_base->get_plugin_instance<Pitch>(name);
+
+        auto* box = ui::pitch_box::create();
+
+        ui::pitch_box::setup(box, plugin_ptr, path);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
+
+        break;
       }
+      case Type::reverb: {
+        GtkWidget* box = nullptr;
+
+        auto plugin_ptr = effects_base->get_plugin_instance<Reverb>(name);
+
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::reverb_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::rnnoise)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<RNNoise>(name);
+          ui::reverb_box::setup(plugin_box, plugin_ptr, path);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::rnnoise_box::create();
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
 
-        ui::rnnoise_box::setup(plugin_box, plugin_ptr, path, self->data->application);
+        gtk_stack_add_named(self->stack, box, name.c_str());
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        break;
       }
+      case Type::rnnoise: {
+        GtkWidget* box = nullptr;
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::speex)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Speex>(name);
+        auto plugin_ptr = effects_base->get_plugin_instance<RNNoise>(name);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::speex_box::create();
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::rnnoise_box::create();
 
-        ui::speex_box::setup(plugin_box, plugin_ptr, path, self->data->application);
+          ui::rnnoise_box::setup(plugin_box, plugin_ptr, path, self->data->application);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
+
+        gtk_stack_add_named(self->stack, box, name.c_str());
+
+        break;
       }
+      case Type::speex: {
+        GtkWidget* box = nullptr;
+
+        auto plugin_ptr = effects_base->get_plugin_instance<Speex>(name);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::stereo_tools)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<StereoTools>(name);
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::speex_box::create();
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::stereo_tools_box::create();
+          ui::speex_box::setup(plugin_box, plugin_ptr, path, self->data->application);
 
-        ui::stereo_tools_box::setup(plugin_box, plugin_ptr, path);
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        gtk_stack_add_named(self->stack, box, name.c_str());
+
+        break;
       }
+      case Type::stereo_tools: {
+        GtkWidget* box = nullptr;
+
+        auto plugin_ptr = effects_base->get_plugin_instance<StereoTools>(name);
+
+        if (plugin_ptr->package_installed) {
+          auto* plugin_box = ui::stereo_tools_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
+          ui::stereo_tools_box::setup(plugin_box, plugin_ptr, path);
+
+          box = GTK_WIDGET(plugin_box);
+        } else {
+          box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+        }
+
+        gtk_stack_add_named(self->stack, box, name.c_str());
+
+        break;
+      }
     }
   }
 
@@ -594,6 +728,24 @@ void on_next_plugin(PluginsBox* self, GtkButton* button) {
   show_adjacent_plugin(self, 1);
 }
 
+auto is_spectrum_tap(PluginsBox* self, GtkToggleButton* button) -> bool {
+  auto* name = static_cast<const char*>(g_object_get_data(G_OBJECT(button), "page-name"));
+
+  return name != nullptr && util::gsettings_get_string(self->settings, "spectrum-tap") == name + ":output"s;
+}
+
+void update_tap_buttons(PluginsBox* self) {
+  for (auto* button : self->data->tap_buttons) {
+    const auto active = is_spectrum_tap(self, button);
+
+    gtk_toggle_button_set_active(button, static_cast<gboolean>(active));
+
+    // the selected tap stays visible when the mouse is not over its row
+
+    gtk_widget_set_opacity(GTK_WIDGET(button), active ? 1.0 : 0.0);
+  }
+}
+
 void setup_listview(PluginsBox* self) {
   auto* factory = gtk_signal_list_item_factory_new();
 
@@ -606,6 +758,7 @@ void setup_listview(PluginsBox* self) {
         auto* top_box = gtk_builder_get_object(builder, "top_box");
         auto* plugin_enabled_icon = gtk_builder_get_object(builder, "plugin_enabled_icon");
         auto* plugin_bypassed_icon = gtk_builder_get_object(builder, "plugin_bypassed_icon");
+        auto* tap = gtk_builder_get_object(builder, "tap");
         auto* remove = gtk_builder_get_object(builder, "remove");
         auto* enable = gtk_builder_get_object(builder, "enable");
         auto* drag_handle = gtk_builder_get_object(builder, "drag_handle");
@@ -614,10 +767,13 @@ void setup_listview(PluginsBox* self) {
         g_object_set_data(G_OBJECT(item), "plugin_enabled_icon", plugin_enabled_icon);
         g_object_set_data(G_OBJECT(item), "plugin_bypassed_icon", plugin_bypassed_icon);
         g_object_set_data(G_OBJECT(item), "name", gtk_builder_get_object(builder, "name"));
+        g_object_set_data(G_OBJECT(item), "tap", tap);
         g_object_set_data(G_OBJECT(item), "remove", remove);
         g_object_set_data(G_OBJECT(item), "enable", enable);
         g_object_set_data(G_OBJECT(item), "drag_handle", drag_handle);
 
+        self->data->tap_buttons.push_back(GTK_TOGGLE_BUTTON(tap));
+
         gtk_list_item_set_child(item, GTK_WIDGET(top_box));
 
         g_object_unref(builder);
@@ -626,12 +782,14 @@ void setup_listview(PluginsBox* self) {
 
         auto* controller = gtk_event_controller_motion_new();
 
+        g_object_set_data(G_OBJECT(controller), "tap", tap);
         g_object_set_data(G_OBJECT(controller), "remove", remove);
         g_object_set_data(G_OBJECT(controller), "enable", enable);
         g_object_set_data(G_OBJECT(controller), "drag_handle", drag_handle);
 
         g_signal_connect(controller, "enter",
                          G_CALLBACK(+[](GtkEventControllerMotion* controller, gdouble x, gdouble y, PluginsBox* self) {
+                           gtk_widget_set_opacity(GTK_WIDGET(g_object_get_data(G_OBJECT(controller), "tap")), 1.0);
                            gtk_widget_set_opacity(GTK_WIDGET(g_object_get_data(G_OBJECT(controller), "remove")), 1.0);
                            gtk_widget_set_opacity(GTK_WIDGET(g_object_get_data(G_OBJECT(controller), "enable")), 1.0);
                            gtk_widget_set_opacity(GTK_WIDGET(g_object_get_data(G_OBJECT(controller), "drag_handle")),
@@ -640,6 +798,9 @@ void setup_listview(PluginsBox* self) {
                          self);
 
         g_signal_connect(controller, "leave", G_CALLBACK(+[](GtkEventControllerMotion* controller, PluginsBox* self) {
+                           auto* tap = GTK_TOGGLE_BUTTON(g_object_get_data(G_OBJECT(controller), "tap"));
+
+                           gtk_widget_set_opacity(GTK_WIDGET(tap), gtk_toggle_button_get_active(tap) != 0 ? 1.0 : 0.0);
                            gtk_widget_set_opacity(GTK_WIDGET(g_object_get_data(G_OBJECT(controller), "remove")), 0.0);
                            gtk_widget_set_opacity(GTK_WIDGET(g_object_get_data(G_OBJECT(controller), "enable")), 0.0);
                            gtk_widget_set_opacity(GTK_WIDGET(g_object_get_data(G_OBJECT(controller), "drag_handle")),
@@ -720,6 +881,24 @@ void setup_listview(PluginsBox* self) {
         gtk_widget_add_controller(GTK_WIDGET(drag_handle), GTK_EVENT_CONTROLLER(drag_source));
         gtk_widget_add_controller(GTK_WIDGET(top_box), GTK_EVENT_CONTROLLER(drop_target));
 
+        g_signal_connect(tap, "toggled", G_CALLBACK(+[](GtkToggleButton* btn, PluginsBox* self) {
+                           auto* name = static_cast<const char*>(g_object_get_data(G_OBJECT(btn), "page-name"));
+
+                           if (name == nullptr) {
+                             return;
+                           }
+
+                           const auto active = gtk_toggle_button_get_active(btn) != 0;
+
+                           // the button state is also updated when the key changes. Only user actions write to it
+
+                           if (active != is_spectrum_tap(self, btn)) {
+                             g_settings_set_string(self->settings, "spectrum-tap",
+                                                   active ? (name + ":output"s).c_str() : "");
+                           }
+                         }),
+                         self);
+
         g_signal_connect(remove, "clicked", G_CALLBACK(+[](GtkButton* btn, PluginsBox* self) {
                            if (auto* name = static_cast<const char*>(g_object_get_data(G_OBJECT(btn), "page-name"));
                                name != nullptr) {
@@ -741,6 +920,7 @@ void setup_listview(PluginsBox* self) {
       factory, "bind", G_CALLBACK(+[](GtkSignalListItemFactory* factory, GtkListItem* item, PluginsBox* self) {
         auto* top_box = static_cast<GtkBox*>(g_object_get_data(G_OBJECT(item), "top_box"));
         auto* label = static_cast<GtkLabel*>(g_object_get_data(G_OBJECT(item), "name"));
+        auto* tap = static_cast<GtkToggleButton*>(g_object_get_data(G_OBJECT(item), "tap"));
         auto* remove = static_cast<GtkButton*>(g_object_get_data(G_OBJECT(item), "remove"));
         auto* enable = static_cast<GtkToggleButton*>(g_object_get_data(G_OBJECT(item), "enable"));
 
@@ -752,6 +932,13 @@ void setup_listview(PluginsBox* self) {
 
         g_object_set_data(G_OBJECT(top_box), "page-name", const_cast<char*>(page_name));
         g_object_set_data(G_OBJECT(remove), "page-name", const_cast<char*>(page_name));
+        g_object_set_data(G_OBJECT(tap), "page-name", const_cast<char*>(page_name));
+
+        const auto tap_active = is_spectrum_tap(self, tap);
+
+        gtk_toggle_button_set_active(tap, static_cast<gboolean>(tap_active));
+
+        gtk_widget_set_opacity(GTK_WIDGET(tap), tap_active ? 1.0 : 0.0);
 
         gtk_label_set_text(label, self->data->translated[base_name].c_str());
 
@@ -777,6 +964,14 @@ void setup_listview(PluginsBox* self) {
       }),
       self);
 
+  g_signal_connect(
+      factory, "teardown", G_CALLBACK(+[](GtkSignalListItemFactory* factory, GtkListItem* item, PluginsBox* self) {
+        auto* tap = static_cast<GtkToggleButton*>(g_object_get_data(G_OBJECT(item), "tap"));
+
+        std::erase(self->data->tap_buttons, tap);
+      }),
+      self);
+
   gtk_list_view_set_factory(self->listview, factory);
 
   g_object_unref(factory);
@@ -833,6 +1028,10 @@ void setup(PluginsBox* self, app::Application* application, PipelineType pipelin
 
   gsettings_bind_widget(self->settings, "show-plugins-list", self->toggle_plugins_list);
 
+  self->data->gconnections.push_back(g_signal_connect(
+      self->settings, "changed::spectrum-tap",
+      G_CALLBACK(+[](GSettings* settings, char* key, PluginsBox* self) { update_tap_buttons(self); }), self));
+
   ui::plugins_menu::setup(self->plugins_menu, application, pipeline_type);
 
   setup_listview(self);
@@ -47,7 +47,7 @@ struct _PreferencesSpectrum {
 
   GtkColorDialogButton *color_button, *axis_color_button;
 
-  GtkDropDown* type;
+  GtkDropDown *type, *mode;
 
   GtkSpinButton *n_points, *height, *line_width, *minimum_frequency, *maximum_frequency;
 
@@ -108,6 +108,7 @@ void preferences_spectrum_class_init(PreferencesSpectrumClass* klass) {
 
   gtk_widget_class_bind_template_child(widget_class, PreferencesSpectrum, show);
   gtk_widget_class_bind_template_child(widget_class, PreferencesSpectrum, type);
+  gtk_widget_class_bind_template_child(widget_class, PreferencesSpectrum, mode);
   gtk_widget_class_bind_template_child(widget_class, PreferencesSpectrum, fill);
   gtk_widget_class_bind_template_child(widget_class, PreferencesSpectrum, n_points);
   gtk_widget_class_bind_template_child(widget_class, PreferencesSpectrum, line_width);
@@ -197,6 +198,7 @@ void preferences_spectrum_init(PreferencesSpectrum* self) {
       self->n_points, self->height, self->line_width, self->minimum_frequency, self->maximum_frequency);
 
   ui::gsettings_bind_enum_to_combo_widget(self->settings, "type", self->type);
+  ui::gsettings_bind_enum_to_combo_widget(self->settings, "mode", self->mode);
 
   // Spectrum gsettings signals connections
 
@@ -0,0 +1,153 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "preset_stage.hpp"
+#include <gio/gio.h>
+#include <glib.h>
+#include <spa/utils/defs.h>
+#include <sys/types.h>
+#include <ranges>
+#include <set>
+#include <string>
+#include <vector>
+#include "effects_base.hpp"
+#include "pipe_manager.hpp"
+#include "pipeline_type.hpp"
+#include "tags_app.hpp"
+#include "tags_plugin_name.hpp"
+#include "tags_schema.hpp"
+#include "util.hpp"
+
+PresetStage::PresetStage(const std::string& tag, PipeManager* pipe_manager, PipelineType pipe_type)
+    : EffectsBase("stage_" + tag, tags::schema::id_app_chain, pipe_manager, pipe_type, make_schema_path(pipe_type)) {
+  spectrum->fade_to(0.0F, 0.0F);
+
+  util::debug(log_tag + "created");
+}
+
+PresetStage::~PresetStage() {
+  disconnect_filters();
+
+  util::debug(log_tag + "destroyed");
+}
+
+auto PresetStage::make_schema_path(const PipelineType& pipe_type) -> std::string {
+  return tags::app::path_preset_stage + std::string((pipe_type == PipelineType::output) ? "output/" : "input/");
+}
+
+auto PresetStage::connect_filters(const uint& source_id, const uint& mix_node_id) -> bool {
+  if (source_id == SPA_ID_INVALID || mix_node_id == SPA_ID_INVALID) {
+    util::debug(log_tag + "the pipeline source or its mixing node is not available. Aborting the link");
+
+    return false;
+  }
+
+  const auto list = util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
+
+  uint prev_node_id = source_id;
+
+  auto link_next = [&](const uint& node_id) {
+    const auto links = pm->link_nodes(prev_node_id, node_id);
+
+    list_proxies.insert(list_proxies.end(), links.begin(), links.end());
+
+    // the microphone may have a single channel
+
+    const auto linked = (prev_node_id == pm->input_device.id) ? !links.empty() : links.size() == 2U;
+
+    if (!linked) {
+      util::warning(log_tag + "link from node " + util::to_string(prev_node_id) + " to node " +
+                    util::to_string(node_id) + " failed");
+
+      return false;
+    }
+
+    prev_node_id = node_id;
+
+    return true;
+  };
+
+  for (const auto& name : list) {
+    if (plugins.contains(name) && !plugins[name]->connected_to_pw) {
+      plugins[name]->start_pw_connection();
+    }
+  }
+
+  for (const auto& name : list) {
+    if (!plugins.contains(name)) {
+      continue;
+    }
+
+    if (!plugins[name]->connected_to_pw ? plugins[name]->connect_to_pw() : true) {
+      if (!plugins[name]->get_bypass()) {
+        link_next(plugins[name]->get_node_id());
+      }
+    }
+  }
+
+  update_filters_activity();
+
+  // without the spectrum fader the stage could not be faded in
+
+  const auto linked = link_next(spectrum->get_node_id()) && link_next(mix_node_id);
+
+  // the probes come after the whole chain so the sidechain cycle check can see the path to the mixing node
+
+  for (const auto& name : list) {
+    if (!plugins.contains(name) || plugins[name]->get_bypass()) {
+      continue;
+    }
+
+    if (name.starts_with(tags::plugin_name::echo_canceller) && plugins[name]->connected_to_pw) {
+      const auto links = pm->link_nodes(pm->output_device.id, plugins[name]->get_node_id(), true);
+
+      list_proxies.insert(list_proxies.end(), links.begin(), links.end());
+    }
+
+    plugins[name]->update_probe_links();
+  }
+
+  return linked;
+}
+
+void PresetStage::disconnect_filters() {
+  std::set<uint> link_id_list;
+
+  for (const auto& plugin : plugins | std::views::values) {
+    for (const auto& link : pm->list_links) {
+      if (link.input_node_id == plugin->get_node_id() || link.output_node_id == plugin->get_node_id()) {
+        link_id_list.insert(link.id);
+      }
+    }
+  }
+
+  for (const auto& link : pm->list_links) {
+    if (link.input_node_id == spectrum->get_node_id() || link.output_node_id == spectrum->get_node_id()) {
+      link_id_list.insert(link.id);
+    }
+  }
+
+  for (const auto& id : link_id_list) {
+    pm->destroy_object(static_cast<int>(id));
+  }
+
+  pm->destroy_links(list_proxies);
+
+  list_proxies.clear();
+}
@@ -18,23 +18,31 @@
  */
 
 #include "presets_manager.hpp"
+#include <fcntl.h>
 #include <gio/gio.h>
 #include <glib-object.h>
 #include <glib.h>
 #include <glib/gi18n.h>
 #include <sys/types.h>
+#include <unistd.h>
 #include <exception>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iomanip>
+#include <ios>
 #include <memory>
+#include <mutex>
 #include <nlohmann/json_fwd.hpp>
 #include <optional>
 #include <ostream>
 #include <regex>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <thread>
 #include <utility>
 #include <vector>
 #include "autogain_preset.hpp"
@@ -72,6 +80,26 @@
 #include "tags_schema.hpp"
 #include "util.hpp"
 
+namespace {
+
+// The data has to reach the disk before the rename. Otherwise a crash could leave an empty file in place of the old one
+
+void sync_file(const std::filesystem::path& path) {
+  const auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if (fd < 0) {
+    return;
+  }
+
+  if (fsync(fd) != 0) {
+    util::warning("fsync failed for: " + path.string());
+  }
+
+  close(fd);
+}
+
+}  // namespace
+
 PresetsManager::PresetsManager()
     : user_config_dir(g_get_user_config_dir()),
       user_input_dir(user_config_dir + "/easyeffects/input"),
@@ -80,6 +108,7 @@ PresetsManager::PresetsManager()
       user_rnnoise_dir(user_config_dir + "/easyeffects/rnnoise"),
       autoload_input_dir(user_config_dir + "/easyeffects/autoload/input"),
       autoload_output_dir(user_config_dir + "/easyeffects/autoload/output"),
+      staging_dir(user_config_dir + "/easyeffects/.staging"),
       settings(g_settings_new(tags::app::id)),
       soe_settings(g_settings_new(tags::schema::id_output)),
       sie_settings(g_settings_new(tags::schema::id_input)) {
@@ -113,6 +142,20 @@ PresetsManager::PresetsManager()
   create_user_directory(autoload_input_dir);
   create_user_directory(autoload_output_dir);
 
+  /*
+    Files are written to the staging directory and then renamed to their final location. It is in the same filesystem
+    as the user directories, so the rename is atomic, and it is not monitored, so the incomplete files are never seen
+    by the lists in the window. Whatever is left there was interrupted by a crash.
+  */
+
+  try {
+    std::filesystem::remove_all(staging_dir);
+  } catch (const std::exception& e) {
+    util::warning(e.what());
+  }
+
+  create_user_directory(staging_dir);
+
   auto* gfile = g_file_new_for_path(user_output_dir.c_str());
 
   user_output_monitor = g_file_monitor_directory(gfile, G_FILE_MONITOR_NONE, nullptr, nullptr);
@@ -214,9 +257,23 @@ PresetsManager::PresetsManager()
                    this);
 
   g_object_unref(gfile);
+
+  worker = std::thread(&PresetsManager::run_tasks, this);
 }
 
 PresetsManager::~PresetsManager() {
+  // the tasks already queued are finished before we leave so that no file is lost
+
+  {
+    std::scoped_lock<std::mutex> lock(tasks_mutex);
+
+    exiting = true;
+  }
+
+  tasks_cv.notify_one();
+
+  worker.join();
+
   g_file_monitor_cancel(user_output_monitor);
   g_file_monitor_cancel(user_input_monitor);
   g_file_monitor_cancel(autoload_input_monitor);
@@ -249,6 +306,115 @@ void PresetsManager::create_user_directory(const std::filesystem::path& path) {
   util::warning("failed to create user presets directory: " + path.string());
 }
 
+void PresetsManager::queue_task(std::function<void()> task) {
+  {
+    std::scoped_lock<std::mutex> lock(tasks_mutex);
+
+    tasks.push_back(std::move(task));
+  }
+
+  tasks_cv.notify_one();
+}
+
+void PresetsManager::run_tasks() {
+  /*
+    One task at a time and in the order they were queued. Besides keeping the disk usage low this guarantees that two
+    tasks never touch the same file at the same time.
+  */
+
+  std::unique_lock<std::mutex> lock(tasks_mutex);
+
+  while (true) {
+    tasks_cv.wait(lock, [this] { return exiting || !tasks.empty(); });
+
+    if (tasks.empty()) {
+      break;
+    }
+
+    auto task = std::move(tasks.front());
+
+    tasks.pop_front();
+
+    lock.unlock();
+
+    task();
+
+    lock.lock();
+  }
+}
+
+void PresetsManager::notify_task_progress(const PresetType& preset_type,
+                                          const std::string& description,
+                                          const double& progress) {
+  util::idle_add([=, this]() { task_progress.emit(preset_type, description, progress); });
+}
+
+void PresetsManager::notify_task_finished(const PresetType& preset_type,
+                                          const std::string& description,
+                                          const bool& success) {
+  util::idle_add([=, this]() { task_finished.emit(preset_type, description, success); });
+}
+
+auto PresetsManager::write_file_atomically(const std::filesystem::path& output_file, const std::string& contents)
+    -> bool {
+  const auto staged_file = staging_dir / output_file.filename();
+
+  try {
+    std::ofstream o(staged_file, std::ios::binary | std::ios::trunc);
+
+    o << contents;
+
+    o.close();
+
+    if (o.fail()) {
+      util::warning("failed to write: " + staged_file.string());
+
+      std::filesystem::remove(staged_file);
+
+      return false;
+    }
+
+    sync_file(staged_file);
+
+    std::filesystem::rename(staged_file, output_file);
+
+    return true;
+  } catch (const std::exception& e) {
+    util::warning("failed to write: " + output_file.string());
+    util::warning(e.what());
+
+    std::error_code ec;
+
+    std::filesystem::remove(staged_file, ec);
+
+    return false;
+  }
+}
+
+auto PresetsManager::copy_file_atomically(const std::filesystem::path& input_file,
+                                          const std::filesystem::path& output_file) -> bool {
+  const auto staged_file = staging_dir / output_file.filename();
+
+  try {
+    std::filesystem::copy_file(input_file, staged_file, std::filesystem::copy_options::overwrite_existing);
+
+    sync_file(staged_file);
+
+    std::filesystem::rename(staged_file, output_file);
+
+    return true;
+  } catch (const std::exception& e) {
+    util::warning("failed to copy " + input_file.string() + " to " + output_file.string());
+    util::warning(e.what());
+
+    std::error_code ec;
+
+    std::filesystem::remove(staged_file, ec);
+
+    return false;
+  }
+}
+
 auto PresetsManager::get_local_presets_name(const PresetType& preset_type) -> std::vector<std::string> {
   const auto conf_dir = (preset_type == PresetType::output) ? user_output_dir : user_input_dir;
 
@@ -571,13 +737,28 @@ void PresetsManager::save_preset_file(const PresetType& preset_type, const std::
     }
   }
 
-  std::ofstream o(output_file.c_str());
+  /*
+    The json is built here because the plugin wrappers read from GSettings. Formatting and writing it is left to the
+    worker thread.
+  */
 
-  o << std::setw(4) << json << '\n';
+  const auto description = _("Saving Preset") + std::string(" ") + name;
+
+  queue_task([=, this, json = std::move(json)]() {
+    notify_task_progress(preset_type, description, 0.0);
 
-  // std::cout << std::setw(4) << json << std::endl;
+    std::ostringstream contents;
+
+    contents << std::setw(4) << json << '\n';
+
+    const auto success = write_file_atomically(output_file, contents.str());
+
+    if (success) {
+      util::debug("saved preset: " + output_file.string());
+    }
 
-  util::debug("saved preset: " + output_file.string());
+    notify_task_finished(preset_type, description, success);
+  });
 }
 
 void PresetsManager::write_plugins_preset(const PresetType& preset_type,
@@ -653,33 +834,122 @@ auto PresetsManager::load_community_preset_file(const PresetType& preset_type,
 }
 
 auto PresetsManager::load_preset_file(const PresetType& preset_type, const std::filesystem::path& input_file) -> bool {
+  if (g_settings_get_int(settings, "preset-crossfade-time") > 0 && !crossfade_requested.empty()) {
+    if (!validate_preset_file(preset_type, input_file)) {
+      return false;
+    }
+
+    crossfade_requested.emit(preset_type, input_file.string());
+
+    return true;
+  }
+
+  return apply_preset_file(preset_type, input_file);
+}
+
+auto PresetsManager::validate_preset_file(const PresetType& preset_type, const std::filesystem::path& input_file)
+    -> bool {
+  const auto* preset_type_str = (preset_type == PresetType::input) ? "input" : "output";
+
+  try {
+    std::ifstream is(input_file);
+
+    nlohmann::json json;
+
+    is >> json;
+
+    const auto& pipeline = json.at(preset_type_str);
+
+    for (const auto& p : pipeline.at("plugins_order").get<std::vector<std::string>>()) {
+      if (tags::plugin_name::find(p) != nullptr && !pipeline.at(p).is_object()) {
+        notify_error(PresetError::plugin_format, p);
+
+        return false;
+      }
+    }
+  } catch (const nlohmann::json::exception& e) {
+    notify_error(PresetError::pipeline_format);
+
+    util::warning(e.what());
+
+    return false;
+  } catch (...) {
+    notify_error(PresetError::pipeline_generic);
+
+    return false;
+  }
+
+  return true;
+}
+
+void PresetsManager::on_deferred_preset_failed(const PresetType& preset_type,
+                                               const std::filesystem::path& preset_file) {
+  util::warning("the preset " + preset_file.string() + " selected for the crossfade could not be applied");
+
+  const auto* lp_key = (preset_type == PresetType::input) ? "last-loaded-input-preset" : "last-loaded-output-preset";
+
+  // a preset requested after this one owns the keys now
+
+  if (util::gsettings_get_string(settings, lp_key) == preset_file.stem().string()) {
+    set_last_preset_keys(preset_type);
+  }
+}
+
+auto PresetsManager::apply_preset_file(const PresetType& preset_type,
+                                       const std::filesystem::path& input_file,
+                                       const std::string& base_path) -> bool {
+  auto* pipeline_settings =
+      (base_path.empty()) ? nullptr : g_settings_new_with_path(tags::schema::id_app_chain, base_path.c_str());
+
   nlohmann::json json;
 
   std::vector<std::string> plugins;
 
   // Read effects_pipeline
-  if (!read_effects_pipeline_from_preset(preset_type, input_file, json, plugins)) {
-    return false;
-  }
+  auto loaded = read_effects_pipeline_from_preset(preset_type, input_file, json, plugins, pipeline_settings);
 
   // After the plugin order list, load the blocklist and then
   // apply the parameters of the loaded plugins.
-  if (load_blocklist(preset_type, json) && read_plugins_preset(preset_type, plugins, json)) {
-    util::debug("successfully loaded the preset: " + input_file.string());
+  loaded = loaded && (!base_path.empty() || load_blocklist(preset_type, json)) &&
+           read_plugins_preset(preset_type, plugins, json, base_path);
 
-    return true;
+  if (pipeline_settings != nullptr) {
+    g_object_unref(pipeline_settings);
   }
 
-  return false;
+  if (loaded) {
+    const auto target = (base_path.empty()) ? std::string() : " into " + base_path;
+
+    util::debug("successfully loaded the preset " + input_file.string() + target);
+  }
+
+  return loaded;
+}
+
+auto PresetsManager::load_app_chain_preset(const std::string& name, const std::string& base_path) -> bool {
+  const auto input_file = user_output_dir / std::filesystem::path{name + json_ext};
+
+  if (!std::filesystem::exists(input_file)) {
+    util::debug("can't find the local preset \"" + name + "\" on the filesystem");
+
+    return false;
+  }
+
+  return apply_preset_file(PresetType::output, input_file, base_path);
 }
 
 auto PresetsManager::read_effects_pipeline_from_preset(const PresetType& preset_type,
                                                        const std::filesystem::path& input_file,
                                                        nlohmann::json& json,
-                                                       std::vector<std::string>& plugins) -> bool {
+                                                       std::vector<std::string>& plugins,
+                                                       GSettings* pipeline_settings) -> bool {
   const auto* preset_type_str = (preset_type == PresetType::input) ? "input" : "output";
 
-  GSettings* settings = (preset_type == PresetType::input) ? sie_settings : soe_settings;
+  GSettings* settings = pipeline_settings;
+
+  if (settings == nullptr) {
+    settings = (preset_type == PresetType::input) ? sie_settings : soe_settings;
+  }
 
   try {
     std::ifstream is(input_file);
@@ -687,20 +957,16 @@ auto PresetsManager::read_effects_pipeline_from_preset(const PresetType& preset_
     is >> json;
 
     for (const auto& p : json.at(preset_type_str).at("plugins_order").get<std::vector<std::string>>()) {
-      for (const auto& v : tags::plugin_name::list) {
-        if (p.starts_with(v)) {
-          /*
-            Old format presets do not have the instance id number in the filter names. They are equal to the
-            base name.
-          */
-
-          if (p != v) {
-            plugins.push_back(p);
-          } else {
-            plugins.push_back(p + "#0");
-          }
-
-          break;
+      if (const auto* descriptor = tags::plugin_name::find(p); descriptor != nullptr) {
+        /*
+          Old format presets do not have the instance id number in the filter names. They are equal to the
+          base name.
+        */
+
+        if (p != descriptor->base_name) {
+          plugins.push_back(p);
+        } else {
+          plugins.push_back(p + "#0");
         }
       }
     }
@@ -723,11 +989,16 @@ auto PresetsManager::read_effects_pipeline_from_preset(const PresetType& preset_
 
 auto PresetsManager::read_plugins_preset(const PresetType& preset_type,
                                          const std::vector<std::string>& plugins,
-                                         const nlohmann::json& json) -> bool {
+                                         const nlohmann::json& json,
+                                         const std::string& base_path) -> bool {
   for (const auto& name : plugins) {
     if (auto wrapper = create_wrapper(preset_type, name); wrapper != std::nullopt) {
       try {
         if (wrapper.has_value()) {
+          if (!base_path.empty()) {
+            wrapper.value()->relocate(base_path);
+          }
+
           wrapper.value()->read(json);
         }
       } catch (const nlohmann::json::exception& e) {
@@ -766,19 +1037,27 @@ void PresetsManager::import_from_filesystem(const PresetType& preset_type, const
 
   const std::filesystem::path out_path = conf_dir / p.filename();
 
-  try {
-    std::filesystem::copy_file(p, out_path, std::filesystem::copy_options::overwrite_existing);
+  const auto description = _("Importing Preset") + std::string(" ") + p.stem().string();
 
-    util::debug("imported preset to: " + out_path.string());
-  } catch (const std::exception& e) {
-    util::warning("can't import preset to: " + out_path.string());
-    util::warning(e.what());
-  }
+  queue_task([=, this]() {
+    notify_task_progress(preset_type, description, 0.0);
+
+    const auto success = copy_file_atomically(p, out_path);
+
+    if (success) {
+      util::debug("imported preset to: " + out_path.string());
+    } else {
+      util::warning("can't import preset to: " + out_path.string());
+    }
+
+    notify_task_finished(preset_type, description, success);
+  });
 }
 
 auto PresetsManager::import_addons_from_community_package(const PresetType& preset_type,
                                                           const std::filesystem::path& path,
-                                                          const std::string& package) -> bool {
+                                                          const std::string& package,
+                                                          const std::string& description) -> bool {
   /* Here we parse the json community preset in order to import the list of addons:
    * 1. Convolver Impulse Response Files
    * 2. RNNoise Models
@@ -812,6 +1091,11 @@ auto PresetsManager::import_addons_from_community_package(const PresetType& pres
       }
     }
 
+    // The preset itself is the last step
+    const auto n_steps = static_cast<double>(conv_irs.size() + rn_models.size() + 1U);
+
+    uint step = 0U;
+
     // For every filename of both vectors, search the full path and copy the file locally.
     for (const auto& irs_name : conv_irs) {
       std::string path;
@@ -822,10 +1106,14 @@ auto PresetsManager::import_addons_from_community_package(const PresetType& pres
         if (util::search_filename(std::filesystem::path{xdg_dir + "/" + package}, irs_name, path, 3U)) {
           const auto out_path = std::filesystem::path{user_irs_dir} / irs_name;
 
-          std::filesystem::copy_file(path, out_path, std::filesystem::copy_options::overwrite_existing);
+          if (!copy_file_atomically(path, out_path)) {
+            return false;
+          }
 
           util::debug("successfully imported community preset addon " + irs_name + " locally");
 
+          notify_task_progress(preset_type, description, static_cast<double>(++step) / n_steps);
+
           found = true;
 
           break;
@@ -848,10 +1136,14 @@ auto PresetsManager::import_addons_from_community_package(const PresetType& pres
         if (util::search_filename(std::filesystem::path{xdg_dir + "/" + package}, model_name, path, 3U)) {
           const auto out_path = std::filesystem::path{user_rnnoise_dir} / model_name;
 
-          std::filesystem::copy_file(path, out_path, std::filesystem::copy_options::overwrite_existing);
+          if (!copy_file_atomically(path, out_path)) {
+            return false;
+          }
 
           util::debug("successfully imported community preset addon " + model_name + " locally");
 
+          notify_task_progress(preset_type, description, static_cast<double>(++step) / n_steps);
+
           found = true;
 
           break;
@@ -897,61 +1189,82 @@ void PresetsManager::import_from_community_package(const PresetType& preset_type
     return;
   }
 
-  bool preset_can_be_copied = false;
+  const auto conf_dir = (preset_type == PresetType::output) ? user_output_dir.string() : user_input_dir.string();
 
-  // We limit the max copy attempts in order to not flood the local directory
-  // if the user keeps clicking the import button.
-  uint i = 0U;
+  const auto description = _("Importing Preset") + std::string(" ") + p.stem().string();
 
-  static const auto max_copy_attempts = 10;
+  queue_task([=, this]() {
+    notify_task_progress(preset_type, description, 0.0);
 
-  const auto conf_dir = (preset_type == PresetType::output) ? user_output_dir.string() : user_input_dir.string();
+    bool preset_can_be_copied = false;
 
-  std::filesystem::path out_path;
+    // We limit the max copy attempts in order to not flood the local directory
+    // if the user keeps clicking the import button.
+    uint i = 0U;
 
-  try {
-    do {
-      // In case of destination file already existing, we try to append
-      // an incremental numeric suffix.
-      const auto suffix = (i == 0U) ? "" : "-" + util::to_string(i);
+    static const auto max_copy_attempts = 10;
 
-      out_path = conf_dir + "/" + p.stem().c_str() + suffix + json_ext;
+    std::filesystem::path out_path;
 
-      if (!std::filesystem::exists(out_path)) {
-        preset_can_be_copied = true;
+    try {
+      do {
+        // In case of destination file already existing, we try to append
+        // an incremental numeric suffix.
+        const auto suffix = (i == 0U) ? "" : "-" + util::to_string(i);
 
-        break;
-      }
-    } while (++i < max_copy_attempts);
-  } catch (const std::exception& e) {
-    util::warning("can't import the community preset: " + p.string());
+        out_path = conf_dir + "/" + p.stem().c_str() + suffix + json_ext;
 
-    util::warning(e.what());
+        if (!std::filesystem::exists(out_path)) {
+          preset_can_be_copied = true;
 
-    return;
-  }
+          break;
+        }
+      } while (++i < max_copy_attempts);
+    } catch (const std::exception& e) {
+      util::warning("can't import the community preset: " + p.string());
 
-  if (!preset_can_be_copied) {
-    util::warning("can't import the community preset: " + p.string());
+      util::warning(e.what());
 
-    util::warning("exceeded the maximum copy attempts; please delete or rename your local preset");
+      notify_task_finished(preset_type, description, false);
 
-    return;
-  }
+      return;
+    }
 
-  // Now we know that the preset is OK to be copied, but we first check for addons.
-  if (!import_addons_from_community_package(preset_type, p, package)) {
-    util::warning("can't import addons for the community preset: " + p.string() +
-                  "; import stage aborted, please reload the community preset list");
+    if (!preset_can_be_copied) {
+      util::warning("can't import the community preset: " + p.string());
 
-    util::warning("if the issue goes on, contact the maintainer of the community package");
+      util::warning("exceeded the maximum copy attempts; please delete or rename your local preset");
 
-    return;
-  }
+      notify_task_finished(preset_type, description, false);
 
-  std::filesystem::copy_file(p, out_path);
+      return;
+    }
 
-  util::debug("successfully imported the community preset to: " + out_path.string());
+    // Now we know that the preset is OK to be copied, but we first check for addons.
+    if (!import_addons_from_community_package(preset_type, p, package, description)) {
+      util::warning("can't import addons for the community preset: " + p.string() +
+                    "; import stage aborted, please reload the community preset list");
+
+      util::warning("if the issue goes on, contact the maintainer of the community package");
+
+      notify_task_finished(preset_type, description, false);
+
+      return;
+    }
+
+    /*
+      The tasks run one at a time, so nothing else of ours can create out_path between the check above and the rename
+      done here.
+    */
+
+    const auto success = copy_file_atomically(p, out_path);
+
+    if (success) {
+      util::debug("successfully imported the community preset to: " + out_path.string());
+    }
+
+    notify_task_finished(preset_type, description, success);
+  });
 }
 
 void PresetsManager::add_autoload(const PresetType& preset_type,
@@ -1196,117 +1509,74 @@ void PresetsManager::notify_error(const PresetError& preset_error, const std::st
 
 auto PresetsManager::create_wrapper(const PresetType& preset_type, std::string_view filter_name)
     -> std::optional<std::unique_ptr<PluginPresetBase>> {
-  auto instance_id = tags::plugin_name::get_id(std::string(filter_name));
-
-  if (filter_name.starts_with(tags::plugin_name::autogain)) {
-    return std::make_unique<AutoGainPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::bass_enhancer)) {
-    return std::make_unique<BassEnhancerPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::bass_loudness)) {
-    return std::make_unique<BassLoudnessPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::compressor)) {
-    return std::make_unique<CompressorPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::convolver)) {
-    return std::make_unique<ConvolverPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::crossfeed)) {
-    return std::make_unique<CrossfeedPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::crystalizer)) {
-    return std::make_unique<CrystalizerPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::deesser)) {
-    return std::make_unique<DeesserPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::delay)) {
-    return std::make_unique<DelayPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::deepfilternet)) {
-    return std::make_unique<DeepFilterNetPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::echo_canceller)) {
-    return std::make_unique<EchoCancellerPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::equalizer)) {
-    return std::make_unique<EqualizerPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::exciter)) {
-    return std::make_unique<ExciterPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::expander)) {
-    return std::make_unique<ExpanderPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::filter)) {
-    return std::make_unique<FilterPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::gate)) {
-    return std::make_unique<GatePreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::level_meter)) {
-    return std::make_unique<LevelMeterPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::limiter)) {
-    return std::make_unique<LimiterPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::loudness)) {
-    return std::make_unique<LoudnessPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::maximizer)) {
-    return std::make_unique<MaximizerPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::multiband_compressor)) {
-    return std::make_unique<MultibandCompressorPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::multiband_gate)) {
-    return std::make_unique<MultibandGatePreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::pitch)) {
-    return std::make_unique<PitchPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::reverb)) {
-    return std::make_unique<ReverbPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::rnnoise)) {
-    return std::make_unique<RNNoisePreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::speex)) {
-    return std::make_unique<SpeexPreset>(preset_type, instance_id);
-  }
-
-  if (filter_name.starts_with(tags::plugin_name::stereo_tools)) {
-    return std::make_unique<StereoToolsPreset>(preset_type, instance_id);
+  using Type = tags::plugin_name::Type;
+
+  const auto* descriptor = tags::plugin_name::find(filter_name);
+
+  if (descriptor == nullptr) {
+    util::warning("The filter name " + std::string(filter_name) + " base name could not be recognized");
+
+    return std::nullopt;
+  }
+
+  auto instance_id = tags::plugin_name::get_id(filter_name);
+
+  switch (descriptor->type) {
+    case Type::autogain:
+      return std::make_unique<AutoGainPreset>(preset_type, instance_id);
+    case Type::bass_enhancer:
+      return std::make_unique<BassEnhancerPreset>(preset_type, instance_id);
+    case Type::bass_loudness:
+      return std::make_unique<BassLoudnessPreset>(preset_type, instance_id);
+    case Type::compressor:
+      return std::make_unique<CompressorPreset>(preset_type, instance_id);
+    case Type::convolver:
+      return std::make_unique<ConvolverPreset>(preset_type, instance_id);
+    case Type::crossfeed:
+      return std::make_unique<CrossfeedPreset>(preset_type, instance_id);
+    case Type::crystalizer:
+      return std::make_unique<CrystalizerPreset>(preset_type, instance_id);
+    case Type::deepfilternet:
+      return std::make_unique<DeepFilterNetPreset>(preset_type, instance_id);
+    case Type::deesser:
+      return std::make_unique<DeesserPreset>(preset_type, instance_id);
+    case Type::delay:
+      return std::make_unique<DelayPreset>(preset_type, instance_id);
+    case Type::echo_canceller:
+      return std::make_unique<EchoCancellerPreset>(preset_type, instance_id);
+    case Type::equalizer:
+      return std::make_unique<EqualizerPreset>(preset_type, instance_id);
+    case Type::exciter:
+      return std::make_unique<ExciterPreset>(preset_type, instance_id);
+    case Type::expander:
+      return std::make_unique<ExpanderPreset>(preset_type, instance_id);
+    case Type::filter:
+      return std::make_unique<FilterPreset>(preset_type, instance_id);
+    case Type::gate:
+      return std::make_unique<GatePreset>(preset_type, instance_id);
+    case Type::level_meter:
+      return std::make_unique<LevelMeterPreset>(preset_type, instance_id);
+    case Type::limiter:
+      return std::make_unique<LimiterPreset>(preset_type, instance_id);
+    case Type::loudness:
+      return std::make_unique<LoudnessPreset>(preset_type, instance_id);
+    case Type::maximizer:
+      return std::make_unique<MaximizerPreset>(preset_type, instance_id);
+    case Type::multiband_compressor:
+      return std::make_unique<MultibandCompressorPreset>(preset_type, instance_id);
+    case Type::multiband_gate:
+      return std::make_unique<MultibandGatePreset>(preset_type, instance_id);
+    case Type::pitch:
+      return std::make_unique<PitchPreset>(preset_type, instance_id);
+    case Type::reverb:
+      return std::make_unique<ReverbPreset>(preset_type, instance_id);
+    case Type::rnnoise:
+      return std::make_unique<RNNoisePreset>(preset_type, instance_id);
+    case Type::speex:
+      return std::make_unique<SpeexPreset>(preset_type, instance_id);
+    case Type::stereo_tools:
+      return std::make_unique<StereoToolsPreset>(preset_type, instance_id);
   }
 
-  util::warning("The filter name " + std::string(filter_name) + " base name could not be recognized");
-
   return std::nullopt;
 }
@@ -37,6 +37,7 @@
 #include "preset_type.hpp"
 #include "tags_app.hpp"
 #include "tags_resources.hpp"
+#include "ui_helpers.hpp"
 #include "util.hpp"
 
 namespace ui::presets_menu {
@@ -79,6 +80,8 @@ struct _PresetsMenu {
 
   GtkButton* refresh_community_list;
 
+  GtkProgressBar* task_progress_bar;
+
   GSettings* settings;
 
   Data* data;
@@ -575,6 +578,35 @@ void setup(PresetsMenu* self, app::Application* application, PresetType preset_t
     gtk_label_set_text(self->last_loaded_preset_title, preset_title.c_str());
   };
 
+  // saving and importing run in the background. The progress bar is shown while they are not finished
+
+  self->data->connections.push_back(self->data->application->presets_manager->task_progress.connect(
+      [=](const PresetType task_preset_type, const std::string& description, const double& progress) {
+        if (task_preset_type != self->data->preset_type) {
+          return;
+        }
+
+        gtk_progress_bar_set_text(self->task_progress_bar, description.c_str());
+        gtk_progress_bar_set_fraction(self->task_progress_bar, progress);
+
+        gtk_widget_set_visible(GTK_WIDGET(self->task_progress_bar), 1);
+      }));
+
+  self->data->connections.push_back(self->data->application->presets_manager->task_finished.connect(
+      [=](const PresetType task_preset_type, const std::string& description, const bool& success) {
+        if (task_preset_type != self->data->preset_type) {
+          return;
+        }
+
+        gtk_widget_set_visible(GTK_WIDGET(self->task_progress_bar), 0);
+
+        if (!success) {
+          auto* active_window = gtk_application_get_active_window(GTK_APPLICATION(self->data->application));
+
+          ui::show_simple_message_dialog(GTK_WIDGET(active_window), _("Preset Operation Failed"), description);
+        }
+      }));
+
   if (preset_type == PresetType::output) {
     setup_community_presets_listview<PresetType::output>(self, self->listview_community, self->presets_list_community);
 
@@ -731,6 +763,7 @@ void presets_menu_class_init(PresetsMenuClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, PresetsMenu, refresh_community_list);
   gtk_widget_class_bind_template_child(widget_class, PresetsMenu, last_loaded_preset_title);
   gtk_widget_class_bind_template_child(widget_class, PresetsMenu, last_loaded_preset_value);
+  gtk_widget_class_bind_template_child(widget_class, PresetsMenu, task_progress_bar);
 
   gtk_widget_class_bind_template_callback(widget_class, create_preset);
   gtk_widget_class_bind_template_callback(widget_class, import_preset_from_disk);
@@ -0,0 +1,221 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "probe_aligner.hpp"
+#include <sys/types.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "util.hpp"
+
+namespace {
+
+// below this correlation the estimate is ignored. Near end speech or a silent reference give low values
+
+constexpr float min_correlation = 0.5F;
+
+// envelope variance below this means the reference is silent. 1e-8 is roughly -80 dB
+
+constexpr float min_probe_variance = 1e-8F;
+
+}  // namespace
+
+void ProbeAligner::setup(const uint& rate) {
+  this->rate = rate;
+
+  frame_size = std::max(1U, rate * frame_ms / 1000U);
+
+  main_envelope.resize(history_frames);
+  probe_envelope.resize(history_frames);
+
+  // room for the largest lag plus the two samples used by the interpolation
+
+  delay_line_L.resize(static_cast<size_t>(max_lag_frames) * frame_size + 2U);
+  delay_line_R.resize(delay_line_L.size());
+
+  reset();
+}
+
+void ProbeAligner::set_margin_ms(const uint& value) {
+  margin_ms = value;
+}
+
+void ProbeAligner::reset() {
+  std::ranges::fill(main_envelope, 0.0F);
+  std::ranges::fill(probe_envelope, 0.0F);
+  std::ranges::fill(delay_line_L, 0.0F);
+  std::ranges::fill(delay_line_R, 0.0F);
+
+  delay = 0.0F;
+  target_delay = 0.0F;
+  frame_position = 0U;
+  main_energy = 0.0F;
+  probe_energy = 0.0F;
+  envelope_position = 0U;
+  n_envelope_frames = 0U;
+  frames_since_estimate = 0U;
+  write_position = 0U;
+}
+
+void ProbeAligner::process(std::span<const float> main, std::span<float> probe_left, std::span<float> probe_right) {
+  if (rate == 0U) {
+    return;
+  }
+
+  const auto capacity = delay_line_L.size();
+
+  const auto max_delay = static_cast<float>(capacity - 2U);
+
+  for (size_t n = 0U; n < main.size(); n++) {
+    // the envelopes are measured before the delay line so the estimate is the absolute lag
+
+    const auto probe_mono = 0.5F * (probe_left[n] + probe_right[n]);
+
+    main_energy += main[n] * main[n];
+    probe_energy += probe_mono * probe_mono;
+
+    if (++frame_position == frame_size) {
+      main_envelope[envelope_position] = std::sqrt(main_energy / static_cast<float>(frame_size));
+      probe_envelope[envelope_position] = std::sqrt(probe_energy / static_cast<float>(frame_size));
+
+      envelope_position = (envelope_position + 1U) % history_frames;
+
+      n_envelope_frames = std::min(n_envelope_frames + 1U, history_frames);
+
+      frame_position = 0U;
+      main_energy = 0.0F;
+      probe_energy = 0.0F;
+
+      if (++frames_since_estimate == frames_between_estimates) {
+        frames_since_estimate = 0U;
+
+        estimate_delay();
+      }
+    }
+
+    delay_line_L[write_position] = probe_left[n];
+    delay_line_R[write_position] = probe_right[n];
+
+    delay += std::clamp(target_delay - delay, -max_slew, max_slew);
+
+    delay = std::clamp(delay, 0.0F, max_delay);
+
+    // linear interpolation between the two samples around the fractional delay
+
+    const auto integer_delay = static_cast<size_t>(delay);
+    const auto fraction = delay - static_cast<float>(integer_delay);
+
+    const auto p0 = (write_position + capacity - integer_delay) % capacity;
+    const auto p1 = (p0 + capacity - 1U) % capacity;
+
+    probe_left[n] = delay_line_L[p0] + fraction * (delay_line_L[p1] - delay_line_L[p0]);
+    probe_right[n] = delay_line_R[p0] + fraction * (delay_line_R[p1] - delay_line_R[p0]);
+
+    write_position = (write_position + 1U) % capacity;
+  }
+}
+
+void ProbeAligner::estimate_delay() {
+  if (n_envelope_frames < history_frames) {
+    return;
+  }
+
+  // oldest frame first
+
+  const auto at = [&](const std::vector<float>& envelope, const uint& index) {
+    return envelope[(envelope_position + index) % history_frames];
+  };
+
+  float main_mean = 0.0F;
+  float probe_mean = 0.0F;
+
+  for (uint n = 0U; n < history_frames; n++) {
+    main_mean += at(main_envelope, n);
+    probe_mean += at(probe_envelope, n);
+  }
+
+  main_mean /= static_cast<float>(history_frames);
+  probe_mean /= static_cast<float>(history_frames);
+
+  std::array<float, max_lag_frames + 1U> correlation{};
+
+  for (uint lag = 0U; lag <= max_lag_frames; lag++) {
+    float cross = 0.0F;
+    float main_variance = 0.0F;
+    float probe_variance = 0.0F;
+
+    for (uint n = lag; n < history_frames; n++) {
+      const auto m = at(main_envelope, n) - main_mean;
+      const auto p = at(probe_envelope, n - lag) - probe_mean;
+
+      cross += m * p;
+      main_variance += m * m;
+      probe_variance += p * p;
+    }
+
+    if (probe_variance < min_probe_variance * static_cast<float>(history_frames) || main_variance == 0.0F) {
+      return;
+    }
+
+    correlation[lag] = cross / std::sqrt(main_variance * probe_variance);
+  }
+
+  const auto best = static_cast<uint>(std::ranges::max_element(correlation) - correlation.begin());
+
+  if (correlation[best] < min_correlation) {
+    return;
+  }
+
+  // parabolic interpolation around the peak gives a resolution finer than one frame
+
+  auto offset = 0.0F;
+
+  if (best > 0U && best < max_lag_frames) {
+    const auto c0 = correlation[best - 1U];
+    const auto c1 = correlation[best];
+    const auto c2 = correlation[best + 1U];
+
+    if (const auto d = c0 - 2.0F * c1 + c2; d < 0.0F) {
+      offset = std::clamp(0.5F * (c0 - c2) / d, -0.5F, 0.5F);
+    }
+  }
+
+  const auto lag_samples = (static_cast<float>(best) + offset) * static_cast<float>(frame_size);
+
+  const auto margin_samples = static_cast<float>(margin_ms * rate) / 1000.0F;
+
+  target_delay = std::max(0.0F, lag_samples - margin_samples);
+
+  /*
+    A jump larger than one frame means the echo is not where the canceller expects it. It will have to adapt again
+    anyway, so there is no point in slowly sliding there. Drift is always much slower than this.
+  */
+
+  if (std::fabs(target_delay - delay) > static_cast<float>(frame_size)) {
+    delay = target_delay;
+  }
+}
+
+auto ProbeAligner::get_memory_usage() const -> size_t {
+  return util::container_bytes(main_envelope) + util::container_bytes(probe_envelope) +
+         util::container_bytes(delay_line_L) + util::container_bytes(delay_line_R);
+}
@@ -27,12 +27,15 @@
 #include <sys/types.h>
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdio>
 #include <memory>
 #include <mutex>
 #include <span>
 #include <string>
+#include "ducker.hpp"
 #include "pipe_manager.hpp"
+#include "pipeline_type.hpp"
 #include "plugin_base.hpp"
 #include "resampler.hpp"
 #include "tags_plugin_name.hpp"
@@ -51,8 +54,6 @@ RNNoise::RNNoise(const std::string& tag,
                  schema_path,
                  pipe_manager,
                  pipe_type),
-      enable_vad(g_settings_get_boolean(settings, "enable-vad")),
-      vad_thres(g_settings_get_double(settings, "vad-thres") / 100.0F),
       data_L(0),
       data_R(0) {
   data_L.reserve(blocksize);
@@ -76,9 +77,13 @@ RNNoise::RNNoise(const std::string& tag,
     system_data_dir_rnnoise.push_back(dir + "easyeffects/rnnoise");
   }
 
-  const auto key_v = g_settings_get_double(settings, "wet");
+  vad_params.update([this](VadParams& p) {
+    const auto key_v = g_settings_get_double(settings, "wet");
 
-  wet_ratio = (key_v <= util::minimum_db_d_level) ? 0.0F : static_cast<float>(util::db_to_linear(key_v));
+    p.enable_vad = g_settings_get_boolean(settings, "enable-vad") != 0;
+    p.vad_thres = static_cast<float>(g_settings_get_double(settings, "vad-thres")) / 100.0F;
+    p.wet_ratio = (key_v <= util::minimum_db_d_level) ? 0.0F : static_cast<float>(util::db_to_linear(key_v));
+  });
 
   gconnections.push_back(g_signal_connect(settings, "changed::model-name",
                                           G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
@@ -113,14 +118,18 @@ RNNoise::RNNoise(const std::string& tag,
 
   gconnections.push_back(g_signal_connect(settings, "changed::enable-vad",
                                           G_CALLBACK(+[](GSettings* settings, char* key, RNNoise* self) {
-                                            self->enable_vad = g_settings_get_boolean(settings, key);
+                                            const auto v = g_settings_get_boolean(settings, key) != 0;
+
+                                            self->vad_params.update([&](VadParams& p) { p.enable_vad = v; });
                                           }),
                                           this));
 
   g_signal_connect(settings, "changed::vad-thres", G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                      auto self = static_cast<RNNoise*>(user_data);
 
-                     self->vad_thres = static_cast<float>(g_settings_get_double(settings, key)) / 100.0F;
+                     const auto v = static_cast<float>(g_settings_get_double(settings, key)) / 100.0F;
+
+                     self->vad_params.update([&](VadParams& p) { p.vad_thres = v; });
                    }),
                    this);
 
@@ -129,8 +138,10 @@ RNNoise::RNNoise(const std::string& tag,
 
                      const auto key_v = g_settings_get_double(settings, key);
 
-                     self->wet_ratio =
+                     const auto v =
                          (key_v <= util::minimum_db_d_level) ? 0.0F : static_cast<float>(util::db_to_linear(key_v));
+
+                     self->vad_params.update([&](VadParams& p) { p.wet_ratio = v; });
                    }),
                    this);
 
@@ -150,14 +161,17 @@ RNNoise::RNNoise(const std::string& tag,
 
   vad_prob_left = 1.0F;
   vad_prob_right = 1.0F;
-  vad_grace_left = release;
-  vad_grace_right = release;
+
+  // no voice was detected yet. Starting the grace period here would duck the output pipeline at launch
+
+  vad_grace_left = 0;
+  vad_grace_right = 0;
 
   rnnoise_ready = true;
 #else
   util::warning("The RNNoise library was not available at compilation time. The noise reduction filter won't work");
 
-  enable_vad = false;
+  vad_params.update([](VadParams& p) { p.enable_vad = false; });
 #endif
 }
 
@@ -207,6 +221,13 @@ void RNNoise::process(std::span<float>& left_in,
                       std::span<float>& right_out) {
   std::scoped_lock<std::mutex> lock(data_mutex);
 
+  const auto& vad = vad_params.acquire();
+
+  enable_vad = vad.enable_vad;
+  vad_thres = vad.vad_thres;
+  wet_ratio = vad.wet_ratio;
+  release = vad.release;
+
   if (bypass || !rnnoise_ready) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
     std::copy(right_in.begin(), right_in.end(), right_out.begin());
@@ -255,6 +276,14 @@ void RNNoise::process(std::span<float>& left_in,
 #endif
   }
 
+#ifdef ENABLE_RNNOISE
+  // the grace period keeps the voice active for a while after the last frame above the threshold
+
+  if (enable_vad && pipeline_type == PipelineType::input) {
+    Ducker::set_voice_detected(vad_grace_left >= 0 || vad_grace_right >= 0);
+  }
+#endif
+
   if (deque_out_L.size() >= left_out.size()) {
     for (float& v : left_out) {
       v = deque_out_L.front();
@@ -429,6 +458,13 @@ auto RNNoise::get_latency_seconds() -> float {
   return latency_value;
 }
 
+auto RNNoise::count_memory_usage() -> size_t {
+  return PluginBase::count_memory_usage() + util::container_bytes(data_L) + util::container_bytes(data_R) +
+         util::container_bytes(data_tmp) + util::container_bytes(resampled_data_L) +
+         util::container_bytes(resampled_data_R) + util::container_bytes(deque_out_L) +
+         util::container_bytes(deque_out_R);
+}
+
 void RNNoise::init_release() {
 #ifdef ENABLE_RNNOISE
 
@@ -439,10 +475,11 @@ void RNNoise::init_release() {
   const auto bs = static_cast<double>(blocksize);
 
   // std::lrint returns a long type
-  const auto release = static_cast<int>(std::lrint(rate * key_v / 1000.0 / bs));
+  const auto v = static_cast<uint>(std::max(std::lrint(rate * key_v / 1000.0 / bs), 0L));
+
+  // the grace counters belong to the realtime thread. The new release is used the next time the voice is detected
 
-  vad_grace_left = release;
-  vad_grace_right = release;
+  vad_params.update([&](VadParams& p) { p.release = v; });
 
 #endif
 }
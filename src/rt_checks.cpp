@@ -0,0 +1,338 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "rt_checks.hpp"
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <poll.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+/*
+  The allocator is replaced through the glibc __libc_* entry points. The other functions are interposed and forwarded
+  to the next definition found by the dynamic linker. Nothing here may allocate or lock while a report is being made
+  because we would recurse into ourselves.
+*/
+
+extern "C" {
+
+auto __libc_malloc(size_t size) -> void*;
+auto __libc_calloc(size_t n, size_t size) -> void*;
+auto __libc_realloc(void* ptr, size_t size) -> void*;
+auto __libc_memalign(size_t alignment, size_t size) -> void*;
+void __libc_free(void* ptr);
+}
+
+namespace {
+
+constexpr auto max_frames = 32;
+
+constexpr auto n_hashed_frames = 12;
+
+constexpr auto sites_size = 4096U;
+
+constexpr auto max_probes = 64U;
+
+constinit thread_local const char* scope_name = nullptr;
+
+constinit thread_local bool inside_report = false;
+
+std::array<std::atomic<uint64_t>, sites_size> reported_sites{};
+
+template <typename T>
+auto next_symbol(std::atomic<T*>& cache, const char* symbol) -> T* {
+  auto* fn = cache.load(std::memory_order_acquire);
+
+  if (fn == nullptr) {
+    fn = reinterpret_cast<T*>(dlsym(RTLD_NEXT, symbol));
+
+    cache.store(fn, std::memory_order_release);
+  }
+
+  return fn;
+}
+
+// Plain aliases instead of decltype(). The glibc declarations carry attributes that std::atomic would ignore
+
+using mutex_fn = int(pthread_mutex_t*);
+using cond_wait_fn = int(pthread_cond_t*, pthread_mutex_t*);
+using cond_timedwait_fn = int(pthread_cond_t*, pthread_mutex_t*, const struct timespec*);
+using join_fn = int(pthread_t, void**);
+using sem_wait_fn = int(sem_t*);
+using nanosleep_fn = int(const struct timespec*, struct timespec*);
+using clock_nanosleep_fn = int(clockid_t, int, const struct timespec*, struct timespec*);
+using usleep_fn = int(useconds_t);
+using poll_fn = int(struct pollfd*, nfds_t, int);
+
+std::atomic<mutex_fn*> real_pthread_mutex_lock;
+std::atomic<mutex_fn*> real_pthread_mutex_trylock;
+std::atomic<cond_wait_fn*> real_pthread_cond_wait;
+std::atomic<cond_timedwait_fn*> real_pthread_cond_timedwait;
+std::atomic<join_fn*> real_pthread_join;
+std::atomic<sem_wait_fn*> real_sem_wait;
+std::atomic<nanosleep_fn*> real_nanosleep;
+std::atomic<clock_nanosleep_fn*> real_clock_nanosleep;
+std::atomic<usleep_fn*> real_usleep;
+std::atomic<poll_fn*> real_poll;
+
+// Returns true only the first time the call chain in `frames` is seen
+
+auto register_site(const std::array<void*, max_frames>& frames, const int& n_frames) -> bool {
+  uint64_t hash = 14695981039346656037U;  // FNV-1a
+
+  for (int n = 0; n < n_frames && n < n_hashed_frames; n++) {
+    hash ^= reinterpret_cast<uintptr_t>(frames[n]);
+    hash *= 1099511628211U;
+  }
+
+  if (hash == 0U) {
+    hash = 1U;
+  }
+
+  for (uint n = 0U; n < max_probes; n++) {
+    auto& slot = reported_sites[(hash + n) % sites_size];
+
+    uint64_t expected = 0U;
+
+    if (slot.compare_exchange_strong(expected, hash, std::memory_order_relaxed)) {
+      return true;
+    }
+
+    if (expected == hash) {
+      return false;
+    }
+  }
+
+  return false;
+}
+
+void report(const char* what) {
+  inside_report = true;
+
+  std::array<void*, max_frames> frames{};
+
+  const auto n_frames = backtrace(frames.data(), max_frames);
+
+  if (register_site(frames, n_frames)) {
+    std::array<char, 512> msg{};
+
+    const auto size = std::snprintf(msg.data(), msg.size(), "rt_checks: %s inside the realtime scope of %s\n", what,
+                                    scope_name);
+
+    if (size > 0) {
+      [[maybe_unused]] const auto written =
+          write(STDERR_FILENO, msg.data(), std::min(static_cast<size_t>(size), msg.size() - 1U));
+    }
+
+    // the first two frames are report() and check()
+
+    backtrace_symbols_fd(frames.data() + 2, n_frames - 2, STDERR_FILENO);
+  }
+
+  inside_report = false;
+}
+
+/*
+  backtrace() loads libgcc_s the first time it is called. That allocates, so we do it once before any realtime scope
+  exists. The interposed symbols are also resolved here so that dlsym is never called from the realtime threads.
+*/
+
+[[gnu::constructor]] void init_rt_checks() {
+  std::array<void*, max_frames> frames{};
+
+  backtrace(frames.data(), max_frames);
+
+  next_symbol(real_pthread_mutex_lock, "pthread_mutex_lock");
+  next_symbol(real_pthread_mutex_trylock, "pthread_mutex_trylock");
+  next_symbol(real_pthread_cond_wait, "pthread_cond_wait");
+  next_symbol(real_pthread_cond_timedwait, "pthread_cond_timedwait");
+  next_symbol(real_pthread_join, "pthread_join");
+  next_symbol(real_sem_wait, "sem_wait");
+  next_symbol(real_nanosleep, "nanosleep");
+  next_symbol(real_clock_nanosleep, "clock_nanosleep");
+  next_symbol(real_usleep, "usleep");
+  next_symbol(real_poll, "poll");
+
+  const auto* msg = "rt_checks: realtime safety checks are enabled\n";
+
+  [[maybe_unused]] const auto written = write(STDERR_FILENO, msg, std::strlen(msg));
+}
+
+}  // namespace
+
+namespace rt_checks {
+
+void enter_scope(const char* name) {
+  scope_name = name;
+}
+
+void leave_scope(const char* previous_name) {
+  scope_name = previous_name;
+}
+
+auto current_scope() -> const char* {
+  return scope_name;
+}
+
+void check(const char* what) {
+  if (scope_name == nullptr || inside_report) {
+    return;
+  }
+
+  report(what);
+}
+
+}  // namespace rt_checks
+
+extern "C" {
+
+// memory allocation
+
+auto malloc(size_t size) -> void* {
+  rt_checks::check("malloc");
+
+  return __libc_malloc(size);
+}
+
+auto calloc(size_t n, size_t size) -> void* {
+  rt_checks::check("calloc");
+
+  return __libc_calloc(n, size);
+}
+
+auto realloc(void* ptr, size_t size) -> void* {
+  rt_checks::check("realloc");
+
+  return __libc_realloc(ptr, size);
+}
+
+auto memalign(size_t alignment, size_t size) -> void* {
+  rt_checks::check("memalign");
+
+  return __libc_memalign(alignment, size);
+}
+
+auto aligned_alloc(size_t alignment, size_t size) -> void* {
+  rt_checks::check("aligned_alloc");
+
+  return __libc_memalign(alignment, size);
+}
+
+auto posix_memalign(void** ptr, size_t alignment, size_t size) -> int {
+  rt_checks::check("posix_memalign");
+
+  if (alignment % sizeof(void*) != 0U || (alignment & (alignment - 1U)) != 0U) {
+    return EINVAL;
+  }
+
+  auto* p = __libc_memalign(alignment, size);
+
+  if (p == nullptr) {
+    return ENOMEM;
+  }
+
+  *ptr = p;
+
+  return 0;
+}
+
+void free(void* ptr) {
+  if (ptr != nullptr) {
+    rt_checks::check("free");
+  }
+
+  __libc_free(ptr);
+}
+
+// locks. Only the contended ones are reported
+
+auto pthread_mutex_lock(pthread_mutex_t* mutex) -> int {
+  if (rt_checks::current_scope() != nullptr) {
+    if (next_symbol(real_pthread_mutex_trylock, "pthread_mutex_trylock")(mutex) == 0) {
+      return 0;
+    }
+
+    rt_checks::check("contended pthread_mutex_lock");
+  }
+
+  return next_symbol(real_pthread_mutex_lock, "pthread_mutex_lock")(mutex);
+}
+
+auto pthread_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex) -> int {
+  rt_checks::check("pthread_cond_wait");
+
+  return next_symbol(real_pthread_cond_wait, "pthread_cond_wait")(cond, mutex);
+}
+
+auto pthread_cond_timedwait(pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* abstime) -> int {
+  rt_checks::check("pthread_cond_timedwait");
+
+  return next_symbol(real_pthread_cond_timedwait, "pthread_cond_timedwait")(cond, mutex, abstime);
+}
+
+auto pthread_join(pthread_t thread, void** retval) -> int {
+  rt_checks::check("pthread_join");
+
+  return next_symbol(real_pthread_join, "pthread_join")(thread, retval);
+}
+
+auto sem_wait(sem_t* sem) -> int {
+  rt_checks::check("sem_wait");
+
+  return next_symbol(real_sem_wait, "sem_wait")(sem);
+}
+
+// blocking syscalls
+
+auto nanosleep(const struct timespec* req, struct timespec* rem) -> int {
+  rt_checks::check("nanosleep");
+
+  return next_symbol(real_nanosleep, "nanosleep")(req, rem);
+}
+
+auto clock_nanosleep(clockid_t clock_id, int flags, const struct timespec* req, struct timespec* rem) -> int {
+  rt_checks::check("clock_nanosleep");
+
+  return next_symbol(real_clock_nanosleep, "clock_nanosleep")(clock_id, flags, req, rem);
+}
+
+auto usleep(useconds_t usec) -> int {
+  rt_checks::check("usleep");
+
+  return next_symbol(real_usleep, "usleep")(usec);
+}
+
+auto poll(struct pollfd* fds, nfds_t nfds, int timeout) -> int {
+  if (timeout != 0) {
+    rt_checks::check("poll");
+  }
+
+  return next_symbol(real_poll, "poll")(fds, nfds, timeout);
+}
+}
@@ -24,12 +24,14 @@
 #include <glib.h>
 #include <sys/types.h>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <mutex>
 #include <numbers>
 #include <span>
 #include <string>
+#include "meters_export.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
@@ -49,14 +51,42 @@ Spectrum::Spectrum(const std::string& tag,
 
   plan = fftwf_plan_dft_r2c_1d(static_cast<int>(n_bands), real_input.data(), complex_output, FFTW_ESTIMATE);
 
+  set_bypass(g_settings_get_boolean(settings, "show") == 0);
+
   g_signal_connect(settings, "changed::show", G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                      auto* self = static_cast<Spectrum*>(user_data);
 
-                     std::scoped_lock<std::mutex> lock(self->data_mutex);
+                     {
+                       std::scoped_lock<std::mutex> lock(self->data_mutex);
+
+                       self->set_bypass(g_settings_get_boolean(settings, key) == 0);
+                     }
 
-                     self->bypass = g_settings_get_boolean(settings, key) == 0;
+                     self->bypass_changed.emit(self->get_bypass());
                    }),
                    this);
+
+  log_mode = util::gsettings_get_string(settings, "mode") == "Logarithmic";
+
+  gconnections.push_back(g_signal_connect(settings, "changed::mode",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                            auto* self = static_cast<Spectrum*>(user_data);
+
+                                            std::scoped_lock<std::mutex> lock(self->data_mutex);
+
+                                            self->log_mode = util::gsettings_get_string(settings, key) == "Logarithmic";
+                                          }),
+                                          this));
+
+  for (const auto* key : {"changed::n-points", "changed::minimum-frequency", "changed::maximum-frequency"}) {
+    gconnections.push_back(g_signal_connect(settings, key,
+                                            G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                              auto* self = static_cast<Spectrum*>(user_data);
+
+                                              self->log_bands_dirty = true;
+                                            }),
+                                            this));
+  }
 }
 
 Spectrum::~Spectrum() {
@@ -104,7 +134,9 @@ void Spectrum::process(std::span<float>& left_in,
   std::copy(left_in.begin(), left_in.end(), left_out.begin());
   std::copy(right_in.begin(), right_in.end(), right_out.begin());
 
-  if (bypass || !fftw_ready) {
+  const auto exporting = export_spectrum.load(std::memory_order_relaxed);
+
+  if ((bypass && !exporting) || !fftw_ready || external_tap) {
     return;
   }
 
@@ -112,15 +144,12 @@ void Spectrum::process(std::span<float>& left_in,
     deque_in_mono.push_back(0.5F * (left_in[n] + right_in[n]));
   }
 
-  for (size_t n = 0; n < deque_in_mono.size(); n++) {
-    if (n < real_input.size()) {
-      // https :  // en.wikipedia.org/wiki/Hann_function
+  std::copy_n(deque_in_mono.begin(), std::min(deque_in_mono.size(), real_input.size()), real_input.begin());
 
-      const float w = 0.5F * (1.0F - std::cos(2.0F * std::numbers::pi_v<float> * static_cast<float>(n) /
-                                              static_cast<float>(real_input.size() - 1U)));
+  // in the logarithmic mode every band applies its own window
 
-      real_input[n] = deque_in_mono[n] * w;
-    }
+  if (!log_mode) {
+    apply_window();
   }
 
   size_t count = 0U;
@@ -132,11 +161,23 @@ void Spectrum::process(std::span<float>& left_in,
   }
 
   if (send_notifications) {
-    util::idle_add([this]() {
-      if (bypass) {
+    util::idle_add([this, use_log_bands = log_mode, exporting]() {
+      const auto show = !get_bypass();
+
+      if (show && use_log_bands) {
+        compute_log_bands();
+      }
+
+      if (!exporting && (!show || use_log_bands)) {
         return;
       }
 
+      // the exported spectrum always has linear bins
+
+      if (use_log_bands) {
+        apply_window();
+      }
+
       fftwf_execute(plan);
 
       for (uint i = 0U; i < output.size(); i++) {
@@ -147,11 +188,203 @@ void Spectrum::process(std::span<float>& left_in,
         output[i] = static_cast<double>(sqr);
       }
 
-      power.emit(rate, output.size(), output);
+      if (show && !use_log_bands) {
+        power.emit(rate, output.size(), output);
+      }
+
+      if (exporting) {
+        meters_export->publish_spectrum(pipeline_type, rate, output);
+      }
     });
   }
 }
 
+void Spectrum::apply_window() {
+  for (size_t n = 0U; n < real_input.size(); n++) {
+    // https :  // en.wikipedia.org/wiki/Hann_function
+
+    const float w = 0.5F * (1.0F - std::cos(2.0F * std::numbers::pi_v<float> * static_cast<float>(n) /
+                                            static_cast<float>(real_input.size() - 1U)));
+
+    real_input[n] *= w;
+  }
+}
+
+void Spectrum::init_log_bands() {
+  log_bands_dirty = false;
+  log_bands_rate = rate;
+
+  log_bands.clear();
+
+  const auto max_freq = std::min(static_cast<double>(g_settings_get_int(settings, "maximum-frequency")),
+                                 0.5 * static_cast<double>(rate));
+  const auto min_freq = static_cast<double>(g_settings_get_int(settings, "minimum-frequency"));
+
+  log_frequencies = util::logspace(min_freq, max_freq, g_settings_get_int(settings, "n-points"));
+
+  log_output.resize(log_frequencies.size());
+
+  if (log_frequencies.size() < 2U) {
+    return;
+  }
+
+  const auto bands_per_octave = static_cast<double>(log_frequencies.size() - 1U) / std::log2(max_freq / min_freq);
+
+  const auto q = 1.0 / (std::pow(2.0, 1.0 / bands_per_octave) - 1.0);
+
+  // a window shorter than this would not hold a few periods of the highest bands
+
+  constexpr auto min_window = 64.0;
+
+  const auto max_window = static_cast<double>(real_input.size());
+
+  log_bands.resize(log_frequencies.size());
+
+  for (size_t k = 0U; k < log_frequencies.size(); k++) {
+    auto& band = log_bands[k];
+
+    band.frequency = log_frequencies[k];
+
+    const auto length = static_cast<size_t>(
+        std::clamp(std::round(q * static_cast<double>(rate) / band.frequency), min_window, max_window));
+
+    band.kernel_cos.resize(length);
+    band.kernel_sin.resize(length);
+
+    const auto omega = 2.0 * std::numbers::pi * band.frequency / static_cast<double>(rate);
+
+    double window_sum = 0.0;
+
+    for (size_t n = 0U; n < length; n++) {
+      const auto w =
+          0.5 * (1.0 - std::cos(2.0 * std::numbers::pi * static_cast<double>(n) / static_cast<double>(length - 1U)));
+
+      band.kernel_cos[n] = static_cast<float>(w * std::cos(omega * static_cast<double>(n)));
+      band.kernel_sin[n] = static_cast<float>(w * std::sin(omega * static_cast<double>(n)));
+
+      window_sum += w;
+    }
+
+    // same scale as the linear mode: a sine of amplitude A has power A^2 / 4
+
+    band.normalization = static_cast<float>(1.0 / (window_sum * window_sum));
+  }
+}
+
+void Spectrum::compute_log_bands() {
+  if (log_bands_dirty || log_bands_rate != rate) {
+    init_log_bands();
+  }
+
+  if (log_bands.empty()) {
+    return;
+  }
+
+  for (size_t k = 0U; k < log_bands.size(); k++) {
+    const auto& band = log_bands[k];
+
+    const auto length = band.kernel_cos.size();
+
+    // the most recent samples are at the end of real_input
+
+    const auto* x = real_input.data() + (real_input.size() - length);
+
+    float re = 0.0F;
+    float im = 0.0F;
+
+    for (size_t n = 0U; n < length; n++) {
+      re += x[n] * band.kernel_cos[n];
+      im += x[n] * band.kernel_sin[n];
+    }
+
+    log_output[k] = static_cast<double>((re * re + im * im) * band.normalization);
+  }
+
+  log_power.emit(log_frequencies, log_output);
+}
+
+void Spectrum::set_external_tap(const bool& state) {
+  std::scoped_lock<std::mutex> lock(data_mutex);
+
+  external_tap = state;
+}
+
+void Spectrum::set_export_spectrum(const bool& state) {
+  export_spectrum.store(state && meters_export != nullptr, std::memory_order_relaxed);
+}
+
+auto Spectrum::is_exported() const -> bool {
+  return export_spectrum.load(std::memory_order_relaxed);
+}
+
+void Spectrum::show_tap_power(const uint& tap_rate, const std::vector<double>& magnitudes) {
+  if (magnitudes.size() < 2U) {
+    return;
+  }
+
+  if (export_spectrum.load(std::memory_order_relaxed)) {
+    meters_export->publish_spectrum(pipeline_type, tap_rate, magnitudes);
+  }
+
+  if (get_bypass()) {
+    return;
+  }
+
+  if (!log_mode) {
+    power.emit(tap_rate, magnitudes.size(), magnitudes);
+
+    return;
+  }
+
+  if (log_bands_dirty || log_bands_rate != rate) {
+    init_log_bands();
+  }
+
+  if (log_frequencies.size() < 2U) {
+    return;
+  }
+
+  // Each band takes the strongest bin between the geometric middle points to its neighbours
+
+  const auto last_bin = magnitudes.size() - 1U;
+
+  const auto bin_width = 0.5 * static_cast<double>(tap_rate) / static_cast<double>(last_bin);
+
+  const auto to_bin = [&](const double& frequency) {
+    return std::min(static_cast<size_t>(std::round(frequency / bin_width)), last_bin);
+  };
+
+  for (size_t k = 0U; k < log_frequencies.size(); k++) {
+    const auto lower = (k == 0U) ? log_frequencies[k] : std::sqrt(log_frequencies[k - 1U] * log_frequencies[k]);
+
+    const auto upper = (k == log_frequencies.size() - 1U) ? log_frequencies[k]
+                                                            : std::sqrt(log_frequencies[k] * log_frequencies[k + 1U]);
+
+    const auto first = magnitudes.begin() + static_cast<std::ptrdiff_t>(to_bin(lower));
+    const auto end = magnitudes.begin() + static_cast<std::ptrdiff_t>(to_bin(upper) + 1U);
+
+    log_output[k] = *std::max_element(first, std::max(end, first + 1));
+  }
+
+  log_power.emit(log_frequencies, log_output);
+}
+
 auto Spectrum::get_latency_seconds() -> float {
   return 0.0F;
 }
+
+auto Spectrum::count_memory_usage() -> size_t {
+  auto bytes = PluginBase::count_memory_usage() + util::container_bytes(real_input) + util::container_bytes(output) +
+               util::container_bytes(deque_in_mono) + util::container_bytes(log_frequencies) +
+               util::container_bytes(log_output);
+
+  for (const auto& band : log_bands) {
+    bytes += util::container_bytes(band.kernel_cos) + util::container_bytes(band.kernel_sin);
+  }
+
+  if (complex_output != nullptr) {
+    bytes += n_bands * sizeof(fftwf_complex);
+  }
+
+  return bytes;
+}
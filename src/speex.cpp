@@ -28,7 +28,9 @@
 #include <mutex>
 #include <span>
 #include <string>
+#include "ducker.hpp"
 #include "pipe_manager.hpp"
+#include "pipeline_type.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
@@ -252,7 +254,10 @@ void Speex::process(std::span<float>& left_in,
     data_R[i] = static_cast<spx_int16_t>(right_in[i] * (SHRT_MAX + 1));
   }
 
-  if (speex_preprocess_run(state_left, data_L.data()) == 1) {
+  const auto voice_left = speex_preprocess_run(state_left, data_L.data()) == 1;
+  const auto voice_right = speex_preprocess_run(state_right, data_R.data()) == 1;
+
+  if (voice_left) {
     for (size_t i = 0; i < n_samples; i++) {
       left_out[i] = static_cast<float>(data_L[i]) * inv_short_max;
     }
@@ -260,7 +265,7 @@ void Speex::process(std::span<float>& left_in,
     std::ranges::fill(left_out, 0.0F);
   }
 
-  if (speex_preprocess_run(state_right, data_R.data()) == 1) {
+  if (voice_right) {
     for (size_t i = 0; i < n_samples; i++) {
       right_out[i] = static_cast<float>(data_R[i]) * inv_short_max;
     }
@@ -268,6 +273,12 @@ void Speex::process(std::span<float>& left_in,
     std::ranges::fill(right_out, 0.0F);
   }
 
+  // without voice activity detection speex_preprocess_run always returns 1
+
+  if (enable_vad != 0 && pipeline_type == PipelineType::input) {
+    Ducker::set_voice_detected(voice_left || voice_right);
+  }
+
   if (output_gain != 1.0F) {
     apply_gain(left_out, right_out, output_gain);
   }
@@ -297,3 +308,7 @@ void Speex::free_speex() {
 auto Speex::get_latency_seconds() -> float {
   return latency_value;
 }
+
+auto Speex::count_memory_usage() -> size_t {
+  return PluginBase::count_memory_usage() + util::container_bytes(data_L) + util::container_bytes(data_R);
+}
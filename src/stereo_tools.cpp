@@ -84,13 +84,13 @@ StereoTools::StereoTools(const std::string& tag,
 
   lv2_wrapper->bind_key_enum<"mode", "mode">(settings);
 
-  const auto key_dry = g_settings_get_double(settings, "dry");
+  mix.update([this](Mix& m) {
+    const auto key_dry = g_settings_get_double(settings, "dry");
+    const auto key_wet = g_settings_get_double(settings, "wet");
 
-  dry = (key_dry <= util::minimum_db_d_level) ? 0.0F : static_cast<float>(util::db_to_linear(key_dry));
-
-  const auto key_wet = g_settings_get_double(settings, "wet");
-
-  wet = (key_wet <= util::minimum_db_d_level) ? 0.0F : static_cast<float>(util::db_to_linear(key_wet));
+    m.dry = (key_dry <= util::minimum_db_d_level) ? 0.0F : static_cast<float>(util::db_to_linear(key_dry));
+    m.wet = (key_wet <= util::minimum_db_d_level) ? 0.0F : static_cast<float>(util::db_to_linear(key_wet));
+  });
 
   gconnections.push_back(g_signal_connect(
       settings, "changed::dry", G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
@@ -98,7 +98,9 @@ StereoTools::StereoTools(const std::string& tag,
 
         const auto key_v = g_settings_get_double(settings, key);
 
-        self->dry = (key_v <= util::minimum_db_d_level) ? 0.0F : static_cast<float>(util::db_to_linear(key_v));
+        const auto v = (key_v <= util::minimum_db_d_level) ? 0.0F : static_cast<float>(util::db_to_linear(key_v));
+
+        self->mix.update([&](Mix& m) { m.dry = v; });
       }),
       this));
 
@@ -108,7 +110,9 @@ StereoTools::StereoTools(const std::string& tag,
 
         const auto key_v = g_settings_get_double(settings, key);
 
-        self->wet = (key_v <= util::minimum_db_d_level) ? 0.0F : static_cast<float>(util::db_to_linear(key_v));
+        const auto v = (key_v <= util::minimum_db_d_level) ? 0.0F : static_cast<float>(util::db_to_linear(key_v));
+
+        self->mix.update([&](Mix& m) { m.wet = v; });
       }),
       this));
 
@@ -153,6 +157,8 @@ void StereoTools::process(std::span<float>& left_in,
   lv2_wrapper->connect_data_ports(left_in, right_in, left_out, right_out);
   lv2_wrapper->run();
 
+  const auto [dry, wet] = mix.acquire();
+
   for (size_t n = 0; n < left_out.size(); n++) {
     left_out[n] = wet * left_out[n] + dry * left_in[n];
 
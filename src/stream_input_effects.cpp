@@ -43,6 +43,10 @@
 
 StreamInputEffects::StreamInputEffects(PipeManager* pipe_manager)
     : EffectsBase("sie: ", tags::schema::id_input, pipe_manager, PipelineType::input) {
+  if (PipeManager::ee_source_is_filter) {
+    pm->set_ee_source_filter(output_level->get_node_id());
+  }
+
   auto* PULSE_SOURCE = std::getenv("PULSE_SOURCE");
 
   if (PULSE_SOURCE != nullptr && PULSE_SOURCE != tags::pipewire::ee_source_name) {
@@ -126,9 +130,29 @@ StreamInputEffects::StreamInputEffects(PipeManager* pipe_manager)
                                             self->set_bypass(false);
                                           }),
                                           this));
+
+  gconnections.push_back(g_signal_connect(settings, "changed::denoiser-comparison",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                            auto* self = static_cast<StreamInputEffects*>(user_data);
+
+                                            self->set_bypass(self->bypass);
+                                          }),
+                                          this));
+
+  gconnections.push_back(g_signal_connect(settings, "changed::denoiser-comparison-output",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                            auto* self = static_cast<StreamInputEffects*>(user_data);
+
+                                            self->update_denoiser_comparison();
+                                          }),
+                                          this));
 }
 
 StreamInputEffects::~StreamInputEffects() {
+  if (denoiser_stats_timeout_id != 0U) {
+    g_source_remove(denoiser_stats_timeout_id);
+  }
+
   disconnect_filters();
 
   util::debug("destroyed");
@@ -174,7 +198,11 @@ void StreamInputEffects::on_link_changed(const LinkInfo link_info) {
   }
 
   if (apps_want_to_play()) {
-    if (list_proxies.empty()) {
+    if (suspended) {
+      util::debug("At least one app linked to our device wants to play. Resuming our filters.");
+
+      resume_filters();
+    } else if (list_proxies.empty()) {
       util::debug("At least one app linked to our device wants to play. Linking our filters.");
 
       connect_filters();
@@ -182,13 +210,16 @@ void StreamInputEffects::on_link_changed(const LinkInfo link_info) {
   } else {
     // no apps want to play, check if the inactivity timer is enabled
     if (g_settings_get_boolean(global_settings, "inactivity-timer-enable")) {
-      // if the timer is enabled, wait for the timeout, then unlink plugin pipeline
+      /*
+        If the timer is enabled, wait for the timeout, then suspend the plugin pipeline. The links are kept so that
+        resuming is just a state change and the first samples recorded by the next app are not lost.
+      */
       int inactivity_timeout = g_settings_get_int(global_settings, "inactivity-timeout");
       g_timeout_add_seconds(inactivity_timeout, GSourceFunc(+[](StreamInputEffects* self) {
-                              if (!self->apps_want_to_play() && !self->list_proxies.empty()) {
-                                util::debug("No app linked to our device wants to play. Unlinking our filters.");
+                              if (!self->apps_want_to_play() && !self->list_proxies.empty() && !self->suspended) {
+                                util::debug("No app linked to our device wants to play. Suspending our filters.");
 
-                                self->disconnect_filters();
+                                self->suspend_filters();
                               }
 
                               return G_SOURCE_REMOVE;
@@ -206,6 +237,8 @@ void StreamInputEffects::on_link_changed(const LinkInfo link_info) {
 }
 
 void StreamInputEffects::connect_filters(const bool& bypass) {
+  update_denoiser_comparison();
+
   const auto input_device_name = util::gsettings_get_string(settings, "input-device");
 
   // checking if the output device exists
@@ -237,8 +270,6 @@ void StreamInputEffects::connect_filters(const bool& bypass) {
   const auto list =
       (bypass) ? std::vector<std::string>() : util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
 
-  auto mic_linked = false;
-
   // waiting for the input device ports information to be available.
 
   int timeout = 0;
@@ -259,75 +290,128 @@ void StreamInputEffects::connect_filters(const bool& bypass) {
   uint prev_node_id = pm->input_device.id;
   uint next_node_id = 0U;
 
+  // outputs of the denoisers being compared. All of them are linked to the node that comes next
+
+  const auto compared = (bypass) ? std::vector<std::string>() : get_compared_denoisers();
+
+  std::vector<uint> parallel_outputs;
+
+  uint parallel_source_id = 0U;
+
+  auto link_from = [&](const uint& source_id, const uint& node_id) {
+    const auto links = pm->link_nodes(source_id, node_id);
+
+    for (auto* link : links) {
+      list_proxies.push_back(link);
+    }
+
+    // the microphone may have a single channel
+
+    const auto linked = (source_id == pm->input_device.id) ? !links.empty() : links.size() == 2U;
+
+    if (!linked) {
+      util::warning(" link from node " + util::to_string(source_id) + " to node " + util::to_string(node_id) +
+                    " failed");
+    }
+
+    return linked;
+  };
+
+  auto link_next = [&](const uint& node_id) {
+    auto linked = false;
+
+    if (parallel_outputs.empty()) {
+      linked = link_from(prev_node_id, node_id);
+    } else {
+      for (const auto& output_id : parallel_outputs) {
+        linked = link_from(output_id, node_id) || linked;
+      }
+
+      parallel_outputs.clear();
+    }
+
+    if (linked) {
+      prev_node_id = node_id;
+    }
+  };
+
   // link plugins
 
   if (!list.empty()) {
+    for (const auto& name : list) {
+      if (plugins.contains(name) && !plugins[name]->connected_to_pw) {
+        plugins[name]->start_pw_connection();
+      }
+    }
+
     for (const auto& name : list) {
       if (!plugins.contains(name)) {
         continue;
       }
 
+      // bypassed plugins are connected but not linked. See EffectsBase::update_filters_activity
+
       if (!plugins[name]->connected_to_pw ? plugins[name]->connect_to_pw() : true) {
+        if (plugins[name]->get_bypass()) {
+          continue;
+        }
+
         next_node_id = plugins[name]->get_node_id();
 
-        const auto links = pm->link_nodes(prev_node_id, next_node_id);
+        if (std::ranges::find(compared, name) == compared.end()) {
+          link_next(next_node_id);
 
-        for (auto* link : links) {
-          list_proxies.push_back(link);
+          continue;
+        }
+
+        if (parallel_outputs.empty()) {
+          parallel_source_id = prev_node_id;
         }
 
-        if (mic_linked && (links.size() == 2U)) {
-          prev_node_id = next_node_id;
-        } else if (!mic_linked && (!links.empty())) {
-          prev_node_id = next_node_id;
-          mic_linked = true;
-        } else {
-          util::warning(" link from node " + util::to_string(prev_node_id) + " to node " +
-                        util::to_string(next_node_id) + " failed");
+        if (link_from(parallel_source_id, next_node_id)) {
+          parallel_outputs.push_back(next_node_id);
         }
       }
     }
+  }
 
-    // checking if we have to link the echo_canceller probe to the output device
+  // link spectrum, output level meter and source node. When the output level filter is our virtual source there is
+  // nothing after it
 
-    for (const auto& name : list) {
-      if (!plugins.contains(name)) {
-        continue;
-      }
+  auto tail_nodes = std::vector<uint>{spectrum->get_node_id(), output_level->get_node_id()};
 
-      if (name.starts_with(tags::plugin_name::echo_canceller)) {
-        if (plugins[name]->connected_to_pw) {
-          for (const auto& link : pm->link_nodes(pm->output_device.id, plugins[name]->get_node_id(), true)) {
-            list_proxies.push_back(link);
-          }
-        }
-      }
+  if (!PipeManager::ee_source_is_filter) {
+    tail_nodes.push_back(pm->ee_source_node.id);
+  }
 
-      plugins[name]->update_probe_links();
-    }
+  for (const auto node_id : tail_nodes) {
+    link_next(node_id);
   }
 
-  // link spectrum, output level meter and source node
+  // The probes are linked only after the whole chain. Otherwise the sidechain cycle check could not see the path
+  // from a plugin to the end of the pipeline
 
-  for (const auto node_id : {spectrum->get_node_id(), output_level->get_node_id(), pm->ee_source_node.id}) {
-    next_node_id = node_id;
+  for (const auto& name : list) {
+    if (!plugins.contains(name) || plugins[name]->get_bypass()) {
+      continue;
+    }
 
-    const auto links = pm->link_nodes(prev_node_id, next_node_id);
+    // checking if we have to link the echo_canceller probe to the output device
 
-    for (auto* link : links) {
-      list_proxies.push_back(link);
+    if (name.starts_with(tags::plugin_name::echo_canceller)) {
+      if (plugins[name]->connected_to_pw) {
+        for (const auto& link : pm->link_nodes(pm->output_device.id, plugins[name]->get_node_id(), true)) {
+          list_proxies.push_back(link);
+        }
+      }
     }
 
-    if (mic_linked && (links.size() == 2U)) {
-      prev_node_id = next_node_id;
-    } else if (!mic_linked && (!links.empty())) {
-      prev_node_id = next_node_id;
-      mic_linked = true;
-    } else {
-      util::warning(" link from node " + util::to_string(prev_node_id) + " to node " + util::to_string(next_node_id) +
-                    " failed");
-    }
+    plugins[name]->update_probe_links();
   }
+
+  update_filters_activity();
+
+  update_shared_lookahead();
 }
 
 void StreamInputEffects::disconnect_filters() {
@@ -352,9 +436,16 @@ void StreamInputEffects::disconnect_filters() {
     }
   }
 
+  // The links from our virtual source to the recording apps are managed by the session manager and must survive
+
+  const auto keep_output_level_links = PipeManager::ee_source_is_filter;
+
+  // the same goes for the links of a preset stage being mixed into the output level
+
   for (const auto& link : pm->list_links) {
     if (link.input_node_id == spectrum->get_node_id() || link.output_node_id == spectrum->get_node_id() ||
-        link.input_node_id == output_level->get_node_id() || link.output_node_id == output_level->get_node_id()) {
+        (link.input_node_id == output_level->get_node_id() && !is_preset_stage_node(link.output_node_id)) ||
+        (!keep_output_level_links && link.output_node_id == output_level->get_node_id())) {
       link_id_list.insert(link.id);
     }
   }
@@ -370,7 +461,33 @@ void StreamInputEffects::disconnect_filters() {
   // remove_unused_filters();
 }
 
+void StreamInputEffects::suspend_filters() {
+  pm->lock();
+
+  deactivate_filters();
+
+  pm->sync_wait_unlock();
+
+  suspended = true;
+}
+
+void StreamInputEffects::resume_filters() {
+  pm->lock();
+
+  activate_filters();
+
+  pm->sync_wait_unlock();
+
+  suspended = false;
+}
+
 void StreamInputEffects::set_bypass(const bool& state) {
+  // filters that are kept connected have to be active again
+
+  if (suspended) {
+    resume_filters();
+  }
+
   bypass = state;
 
   disconnect_filters();
@@ -378,6 +495,99 @@ void StreamInputEffects::set_bypass(const bool& state) {
   connect_filters(state);
 }
 
+auto StreamInputEffects::get_compared_denoisers() -> std::vector<std::string> {
+  using Type = tags::plugin_name::Type;
+
+  std::vector<std::string> compared;
+
+  if (g_settings_get_boolean(settings, "denoiser-comparison") == 0) {
+    return compared;
+  }
+
+  /*
+    Only the first run of adjacent denoisers is compared. Muting one of them anywhere else would silence the pipeline.
+    Bypassed plugins are not linked, so they neither take part nor break the run.
+  */
+
+  for (const auto& name : util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"))) {
+    if (plugins.contains(name) && plugins[name]->get_bypass()) {
+      continue;
+    }
+
+    const auto* descriptor = tags::plugin_name::find(name);
+
+    const auto is_denoiser = descriptor != nullptr && (descriptor->type == Type::rnnoise ||
+                                                       descriptor->type == Type::deepfilternet ||
+                                                       descriptor->type == Type::speex);
+
+    if (is_denoiser && plugins.contains(name)) {
+      compared.push_back(name);
+    } else if (!compared.empty()) {
+      break;
+    }
+  }
+
+  return compared;
+}
+
+void StreamInputEffects::update_denoiser_comparison() {
+  const auto compared = (bypass) ? std::vector<std::string>() : get_compared_denoisers();
+
+  auto monitored = util::gsettings_get_string(settings, "denoiser-comparison-output");
+
+  if (!compared.empty() && std::ranges::find(compared, monitored) == compared.end()) {
+    monitored = compared.front();
+  }
+
+  for (const auto& [name, plugin] : plugins) {
+    plugin->output_muted = std::ranges::find(compared, name) != compared.end() && name != monitored;
+  }
+
+  // only the monitored denoiser adds latency to what is heard
+
+  broadcast_pipeline_latency();
+
+  if (!compared.empty() && denoiser_stats_timeout_id == 0U) {
+    denoiser_stats_timeout_id = g_timeout_add_seconds(1, GSourceFunc(+[](StreamInputEffects* self) {
+                                                        self->broadcast_denoiser_stats();
+
+                                                        return G_SOURCE_CONTINUE;
+                                                      }),
+                                                      this);
+  } else if (compared.empty() && denoiser_stats_timeout_id != 0U) {
+    g_source_remove(denoiser_stats_timeout_id);
+
+    denoiser_stats_timeout_id = 0U;
+
+    denoiser_stats.emit({});
+  }
+
+  // the interface does not have to wait for the timer to show the monitored denoiser
+
+  if (!compared.empty()) {
+    broadcast_denoiser_stats();
+  }
+}
+
+void StreamInputEffects::broadcast_denoiser_stats() {
+  std::vector<DenoiserStats> stats;
+
+  for (const auto& name : get_compared_denoisers()) {
+    const auto& plugin = plugins[name];
+
+    stats.push_back({.name = name,
+                     .dsp_load = plugin->dsp_load.load(std::memory_order_relaxed),
+                     .latency_ms = 1000.0F * plugin->get_latency_seconds(),
+                     .monitored = !plugin->output_muted});
+
+    util::debug(log_tag + name + (plugin->output_muted ? "" : " (monitored)") + ": " +
+                util::to_string(100.0F * stats.back().dsp_load, "") + " % of the processing time, latency " +
+                util::to_string(stats.back().latency_ms, "") + " ms");
+  }
+
+  denoiser_stats.emit(stats);
+}
+
 void StreamInputEffects::set_listen_to_mic(const bool& state) {
   if (state) {
     for (const auto& link : pm->link_nodes(pm->ee_source_node.id, pm->output_device.id, false, false)) {
@@ -389,3 +599,27 @@ void StreamInputEffects::set_listen_to_mic(const bool& state) {
     list_proxies_listen_mic.clear();
   }
 }
+
+auto StreamInputEffects::get_chain_source_id() -> uint {
+  // The denoisers being compared are linked in parallel. Bypassing one of them may change the run being compared
+
+  const auto comparing = g_settings_get_boolean(settings, "denoiser-comparison") != 0;
+
+  return (bypass || suspended || comparing) ? SPA_ID_INVALID : pm->input_device.id;
+}
+
+void StreamInputEffects::relink_filters() {
+  set_bypass(bypass);
+}
+
+auto StreamInputEffects::is_suspended() -> bool {
+  return suspended;
+}
+
+void StreamInputEffects::on_filters_bypass_changed() {
+  // the muting has to follow the compared denoisers even when the pipeline is not linked
+
+  if (g_settings_get_boolean(settings, "denoiser-comparison") != 0) {
+    update_denoiser_comparison();
+  }
+}
@@ -27,13 +27,18 @@
 #include <spa/utils/defs.h>
 #include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <memory>
 #include <ranges>
 #include <set>
 #include <string>
 #include <thread>
 #include <vector>
+#include "app_chain.hpp"
+#include "ducker.hpp"
 #include "effects_base.hpp"
+#include "output_level.hpp"
 #include "pipe_manager.hpp"
 #include "pipe_objects.hpp"
 #include "tags_pipewire.hpp"
@@ -81,7 +86,11 @@ StreamOutputEffects::StreamOutputEffects(PipeManager* pipe_manager)
   }));
 
   connections.push_back(pm->stream_output_added.connect(sigc::mem_fun(*this, &StreamOutputEffects::on_app_added)));
+  connections.push_back(
+      pm->stream_output_removed.connect(sigc::mem_fun(*this, &StreamOutputEffects::on_app_removed)));
   connections.push_back(pm->link_changed.connect(sigc::mem_fun(*this, &StreamOutputEffects::on_link_changed)));
+  connections.push_back(
+      pm->app_chain_sink_added.connect(sigc::mem_fun(*this, &StreamOutputEffects::on_app_chain_sink_added)));
 
   connect_filters();
 
@@ -126,14 +135,48 @@ StreamOutputEffects::StreamOutputEffects(PipeManager* pipe_manager)
                                             self->set_bypass(false);
                                           }),
                                           this));
+
+  update_ducking();
+
+  for (const auto* key : {"changed::ducking", "changed::ducking-reduction", "changed::ducking-attack",
+                          "changed::ducking-release"}) {
+    gconnections.push_back(g_signal_connect(settings, key,
+                                            G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                              auto* self = static_cast<StreamOutputEffects*>(user_data);
+
+                                              self->update_ducking();
+                                            }),
+                                            this));
+  }
 }
 
 StreamOutputEffects::~StreamOutputEffects() {
+  app_chains.clear();
+
   disconnect_filters();
 
   util::debug("destroyed");
 }
 
+void StreamOutputEffects::update_ducking() {
+  // The application chains are linked to the output device without going through this pipeline. Their own output
+  // level ducks them with the same settings
+
+  std::vector<Ducker*> duckers = {&output_level->ducker};
+
+  for (auto& chain : app_chains | std::views::values) {
+    duckers.push_back(&chain->output_level->ducker);
+  }
+
+  for (auto* ducker : duckers) {
+    ducker->reduction_db = static_cast<float>(g_settings_get_double(settings, "ducking-reduction"));
+    ducker->attack_ms = static_cast<float>(g_settings_get_double(settings, "ducking-attack"));
+    ducker->release_ms = static_cast<float>(g_settings_get_double(settings, "ducking-release"));
+
+    ducker->enabled = g_settings_get_boolean(settings, "ducking") != 0;
+  }
+}
+
 void StreamOutputEffects::on_app_added(const NodeInfo node_info) {
   const auto blocklist = util::gchar_array_to_vector(g_settings_get_strv(settings, "blocklist"));
 
@@ -141,9 +184,97 @@ void StreamOutputEffects::on_app_added(const NodeInfo node_info) {
 
   is_blocklisted = is_blocklisted || std::ranges::find(blocklist, node_info.name) != blocklist.end();
 
-  if (g_settings_get_boolean(global_settings, "process-all-outputs") != 0 && !is_blocklisted) {
+  // a stream assigned to a chain is connected by route_to_app_chain
+
+  if (g_settings_get_boolean(global_settings, "process-all-outputs") != 0 && !is_blocklisted &&
+      !route_to_app_chain(node_info)) {
+    pm->connect_stream_output(node_info.id);
+  }
+}
+
+auto StreamOutputEffects::route_to_app_chain(const NodeInfo& node_info) -> bool {
+  auto* assignments = g_settings_get_value(settings, "app-chains");
+
+  std::string key, preset_name;
+
+  for (const auto& candidate : {node_info.application_id, node_info.name}) {
+    gchar* value = nullptr;
+
+    if (!candidate.empty() && g_variant_lookup(assignments, candidate.c_str(), "s", &value) != 0) {
+      key = candidate;
+      preset_name = value;
+
+      g_free(value);
+
+      break;
+    }
+  }
+
+  g_variant_unref(assignments);
+
+  if (key.empty()) {
+    return false;
+  }
+
+  if (!app_chains.contains(key)) {
+    // the preset is loaded before the chain exists so its plugins are created only once
+
+    load_app_chain_preset.emit(preset_name, AppChain::make_schema_path(key));
+
+    app_chains[key] = std::make_unique<AppChain>(key, pm);
+
+    update_ducking();
+  }
+
+  auto& chain = app_chains[key];
+
+  chain->streams[node_info.serial] = node_info.id;
+
+  // until the chain sink is available the stream waits for on_app_chain_sink_added
+
+  if (chain->sink.id != SPA_ID_INVALID) {
+    pm->set_app_chain_route(node_info.id, chain->sink);
+
     pm->connect_stream_output(node_info.id);
   }
+
+  return true;
+}
+
+void StreamOutputEffects::on_app_chain_sink_added(const NodeInfo node_info) {
+  for (auto& chain : app_chains | std::views::values) {
+    if (chain->sink.name != node_info.name) {
+      continue;
+    }
+
+    chain->set_sink(node_info);
+
+    for (const auto& id : chain->streams | std::views::values) {
+      pm->set_app_chain_route(id, chain->sink);
+
+      pm->connect_stream_output(id);
+    }
+
+    return;
+  }
+}
+
+void StreamOutputEffects::on_app_removed(const uint64_t serial) {
+  for (auto it = app_chains.begin(); it != app_chains.end(); it++) {
+    auto& chain = it->second;
+
+    if (const auto stream = chain->streams.find(serial); stream != chain->streams.end()) {
+      pm->remove_app_chain_route(stream->second);
+
+      chain->streams.erase(stream);
+
+      if (chain->streams.empty()) {
+        app_chains.erase(it);
+      }
+
+      return;
+    }
+  }
 }
 
 auto StreamOutputEffects::apps_want_to_play() -> bool {
@@ -237,12 +368,24 @@ void StreamOutputEffects::connect_filters(const bool& bypass) {
   // link plugins
 
   if (!list.empty()) {
+    for (const auto& name : list) {
+      if (plugins.contains(name) && !plugins[name]->connected_to_pw) {
+        plugins[name]->start_pw_connection();
+      }
+    }
+
     for (const auto& name : list) {
       if (!plugins.contains(name)) {
         continue;
       }
 
+      // bypassed plugins are connected but not linked. See EffectsBase::update_filters_activity
+
       if (!plugins[name]->connected_to_pw ? plugins[name]->connect_to_pw() : true) {
+        if (plugins[name]->get_bypass()) {
+          continue;
+        }
+
         next_node_id = plugins[name]->get_node_id();
 
         const auto links = pm->link_nodes(prev_node_id, next_node_id);
@@ -259,24 +402,6 @@ void StreamOutputEffects::connect_filters(const bool& bypass) {
         }
       }
     }
-
-    // checking if we have to link the echo_canceller probe to the output device
-
-    for (const auto& name : list) {
-      if (!plugins.contains(name)) {
-        continue;
-      }
-
-      if (name.starts_with(tags::plugin_name::echo_canceller)) {
-        if (plugins[name]->connected_to_pw) {
-          for (const auto& link : pm->link_nodes(pm->output_device.id, plugins[name]->get_node_id(), true)) {
-            list_proxies.push_back(link);
-          }
-        }
-      }
-
-      plugins[name]->update_probe_links();
-    }
   }
 
   // link spectrum and output level meter
@@ -329,6 +454,31 @@ void StreamOutputEffects::connect_filters(const bool& bypass) {
     util::warning(" link from node " + util::to_string(prev_node_id) + " to output device " +
                   util::to_string(next_node_id) + " failed");
   }
+
+  // The probes are linked only after the whole chain. Otherwise the sidechain cycle check could not see the path
+  // from a plugin to the end of the pipeline
+
+  for (const auto& name : list) {
+    if (!plugins.contains(name) || plugins[name]->get_bypass()) {
+      continue;
+    }
+
+    // checking if we have to link the echo_canceller probe to the output device
+
+    if (name.starts_with(tags::plugin_name::echo_canceller)) {
+      if (plugins[name]->connected_to_pw) {
+        for (const auto& link : pm->link_nodes(pm->output_device.id, plugins[name]->get_node_id(), true)) {
+          list_proxies.push_back(link);
+        }
+      }
+    }
+
+    plugins[name]->update_probe_links();
+  }
+
+  update_filters_activity();
+
+  update_shared_lookahead();
 }
 
 void StreamOutputEffects::disconnect_filters() {
@@ -377,4 +527,18 @@ void StreamOutputEffects::set_bypass(const bool& state) {
   disconnect_filters();
 
   connect_filters(state);
+
+  // the chains are relinked too because the output device may have changed
+
+  for (auto& chain : app_chains | std::views::values) {
+    chain->set_bypass(state);
+  }
+}
+
+auto StreamOutputEffects::get_chain_source_id() -> uint {
+  return (bypass) ? SPA_ID_INVALID : pm->ee_sink_node.id;
+}
+
+void StreamOutputEffects::relink_filters() {
+  set_bypass(bypass);
 }
@@ -20,174 +20,85 @@
 #include "tags_plugin_name.hpp"
 #include <glib/gi18n.h>
 #include <sys/types.h>
+#include <algorithm>
 #include <map>
-#include <regex>
 #include <string>
 #include <string_view>
 #include "util.hpp"
 
-namespace {
-
-const auto id_regex = std::regex(R"(#(\d+)$)");
-
-}
-
 namespace tags::plugin_name {
 
-auto get_translated() -> std::map<std::string, std::string> {
-  std::map<std::string, std::string> translated = {{autogain, _("Autogain")},
-                                                   {bass_enhancer, _("Bass Enhancer")},
-                                                   {bass_loudness, _("Bass Loudness")},
-                                                   {compressor, _("Compressor")},
-                                                   {convolver, _("Convolver")},
-                                                   {crossfeed, _("Crossfeed")},
-                                                   {crystalizer, _("Crystalizer")},
-                                                   {deepfilternet, _("Deep Noise Remover")},
-                                                   {deesser, _("Deesser")},
-                                                   {delay, _("Delay")},
-                                                   {echo_canceller, _("Echo Canceller")},
-                                                   {equalizer, _("Equalizer")},
-                                                   {exciter, _("Exciter")},
-                                                   {expander, _("Expander")},
-                                                   {filter, _("Filter")},
-                                                   {gate, _("Gate")},
-                                                   {level_meter, _("Level Meter")},
-                                                   {limiter, _("Limiter")},
-                                                   {loudness, _("Loudness")},
-                                                   {maximizer, _("Maximizer")},
-                                                   {multiband_compressor, _("Multiband Compressor")},
-                                                   {multiband_gate, _("Multiband Gate")},
-                                                   {pitch, _("Pitch")},
-                                                   {reverb, _("Reverberation")},
-                                                   {rnnoise, _("Noise Reduction")},
-                                                   {speex, _("Speech Processor")},
-                                                   {stereo_tools, _("Stereo Tools")}};
+auto find(std::string_view name) -> const Descriptor* {
+  // removing the instance id
 
-  return translated;
-}
-
-auto get_base_name(std::string_view name) -> std::string {
-  if (name.starts_with(tags::plugin_name::autogain)) {
-    return tags::plugin_name::autogain;
+  if (const auto separator = name.rfind('#'); separator != std::string_view::npos) {
+    name = name.substr(0U, separator);
   }
 
-  if (name.starts_with(tags::plugin_name::bass_enhancer)) {
-    return tags::plugin_name::bass_enhancer;
-  }
-
-  if (name.starts_with(tags::plugin_name::bass_loudness)) {
-    return tags::plugin_name::bass_loudness;
-  }
-
-  if (name.starts_with(tags::plugin_name::compressor)) {
-    return tags::plugin_name::compressor;
-  }
-
-  if (name.starts_with(tags::plugin_name::convolver)) {
-    return tags::plugin_name::convolver;
-  }
-
-  if (name.starts_with(tags::plugin_name::crossfeed)) {
-    return tags::plugin_name::crossfeed;
-  }
-
-  if (name.starts_with(tags::plugin_name::crystalizer)) {
-    return tags::plugin_name::crystalizer;
-  }
-
-  if (name.starts_with(tags::plugin_name::deepfilternet)) {
-    return tags::plugin_name::deepfilternet;
-  }
-
-  if (name.starts_with(tags::plugin_name::deesser)) {
-    return tags::plugin_name::deesser;
-  }
-
-  if (name.starts_with(tags::plugin_name::delay)) {
-    return tags::plugin_name::delay;
-  }
-
-  if (name.starts_with(tags::plugin_name::echo_canceller)) {
-    return tags::plugin_name::echo_canceller;
-  }
-
-  if (name.starts_with(tags::plugin_name::equalizer)) {
-    return tags::plugin_name::equalizer;
-  }
+  const auto it = std::ranges::lower_bound(descriptors, name, {},
+                                           [](const Descriptor& d) { return std::string_view(d.base_name); });
 
-  if (name.starts_with(tags::plugin_name::exciter)) {
-    return tags::plugin_name::exciter;
+  if (it == descriptors.end() || std::string_view(it->base_name) != name) {
+    return nullptr;
   }
 
-  if (name.starts_with(tags::plugin_name::expander)) {
-    return tags::plugin_name::expander;
-  }
-
-  if (name.starts_with(tags::plugin_name::filter)) {
-    return tags::plugin_name::filter;
-  }
-
-  if (name.starts_with(tags::plugin_name::gate)) {
-    return tags::plugin_name::gate;
-  }
-
-  if (name.starts_with(tags::plugin_name::level_meter)) {
-    return tags::plugin_name::level_meter;
-  }
-
-  if (name.starts_with(tags::plugin_name::limiter)) {
-    return tags::plugin_name::limiter;
-  }
-
-  if (name.starts_with(tags::plugin_name::loudness)) {
-    return tags::plugin_name::loudness;
-  }
-
-  if (name.starts_with(tags::plugin_name::maximizer)) {
-    return tags::plugin_name::maximizer;
-  }
-
-  if (name.starts_with(tags::plugin_name::multiband_compressor)) {
-    return tags::plugin_name::multiband_compressor;
-  }
-
-  if (name.starts_with(tags::plugin_name::multiband_gate)) {
-    return tags::plugin_name::multiband_gate;
-  }
-
-  if (name.starts_with(tags::plugin_name::pitch)) {
-    return tags::plugin_name::pitch;
-  }
+  return &*it;
+}
 
-  if (name.starts_with(tags::plugin_name::reverb)) {
-    return tags::plugin_name::reverb;
-  }
+auto get_descriptor(const Type& type) -> const Descriptor& {
+  return descriptors[static_cast<size_t>(type)];
+}
 
-  if (name.starts_with(tags::plugin_name::rnnoise)) {
-    return tags::plugin_name::rnnoise;
-  }
+auto get_translated() -> const std::map<std::string, std::string>& {
+  // Built only once. Gettext is initialized before anything asks for a translated name
+
+  static const std::map<std::string, std::string> translated = {{autogain, _("Autogain")},
+                                                                {bass_enhancer, _("Bass Enhancer")},
+                                                                {bass_loudness, _("Bass Loudness")},
+                                                                {compressor, _("Compressor")},
+                                                                {convolver, _("Convolver")},
+                                                                {crossfeed, _("Crossfeed")},
+                                                                {crystalizer, _("Crystalizer")},
+                                                                {deepfilternet, _("Deep Noise Remover")},
+                                                                {deesser, _("Deesser")},
+                                                                {delay, _("Delay")},
+                                                                {echo_canceller, _("Echo Canceller")},
+                                                                {equalizer, _("Equalizer")},
+                                                                {exciter, _("Exciter")},
+                                                                {expander, _("Expander")},
+                                                                {filter, _("Filter")},
+                                                                {gate, _("Gate")},
+                                                                {level_meter, _("Level Meter")},
+                                                                {limiter, _("Limiter")},
+                                                                {loudness, _("Loudness")},
+                                                                {maximizer, _("Maximizer")},
+                                                                {multiband_compressor, _("Multiband Compressor")},
+                                                                {multiband_gate, _("Multiband Gate")},
+                                                                {pitch, _("Pitch")},
+                                                                {reverb, _("Reverberation")},
+                                                                {rnnoise, _("Noise Reduction")},
+                                                                {speex, _("Speech Processor")},
+                                                                {stereo_tools, _("Stereo Tools")}};
 
-  if (name.starts_with(tags::plugin_name::speex)) {
-    return tags::plugin_name::speex;
-  }
+  return translated;
+}
 
-  if (name.starts_with(tags::plugin_name::stereo_tools)) {
-    return tags::plugin_name::stereo_tools;
+auto get_base_name(std::string_view name) -> std::string {
+  if (const auto* descriptor = find(name); descriptor != nullptr) {
+    return descriptor->base_name;
   }
 
   return "";
 }
 
-auto get_id(const std::string& name) -> uint {
-  std::smatch matches;
-
-  std::regex_search(name, matches, id_regex);
+auto get_id(std::string_view name) -> uint {
+  const auto separator = name.rfind('#');
 
-  if (matches.size() != 2U) {
+  if (separator == std::string_view::npos) {
     return 0U;
   }
 
-  if (uint id = 0U; util::str_to_num(matches[1], id)) {
+  if (uint id = 0U; util::str_to_num(std::string(name.substr(separator + 1U)), id)) {
     return id;
   }
 
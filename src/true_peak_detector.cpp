@@ -0,0 +1,144 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "true_peak_detector.hpp"
+#include <sys/types.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "util.hpp"
+
+void TruePeakDetector::setup(const uint& rate, const uint& block_size) {
+  // the history is at the beginning of the buffers, so it survives the resize
+
+  if (block_size != max_block_size) {
+    max_block_size = block_size;
+
+    buffer_L.resize(taps_per_phase - 1U + block_size);
+    buffer_R.resize(taps_per_phase - 1U + block_size);
+
+    phase_output.resize(block_size);
+  }
+
+  if (rate == current_rate) {
+    return;
+  }
+
+  current_rate = rate;
+
+  if (rate < 96000U) {
+    factor = 4U;
+  } else if (rate < 192000U) {
+    factor = 2U;
+  } else {
+    factor = 1U;
+  }
+
+  // The phases of the Annex filter are convolved. Here they are applied in the order of the buffer, oldest sample first
+
+  coefficients = {};
+
+  if (factor == 1U) {
+    coefficients[0][taps_per_phase - 1U] = 1.0F;
+  } else {
+    for (uint p = 0U; p < factor; p++) {
+      std::ranges::reverse_copy(bs1770_coefficients[p * (max_factor / factor)], coefficients[p].begin());
+    }
+  }
+
+  reset();
+}
+
+void TruePeakDetector::reset() {
+  std::ranges::fill(buffer_L, 0.0F);
+  std::ranges::fill(buffer_R, 0.0F);
+
+  peak_L = 0.0F;
+  peak_R = 0.0F;
+}
+
+void TruePeakDetector::process(std::span<const float> left, std::span<const float> right) {
+  if (max_block_size == 0U) {
+    return;
+  }
+
+  for (size_t offset = 0U; offset < left.size(); offset += max_block_size) {
+    const auto count = std::min(static_cast<size_t>(max_block_size), left.size() - offset);
+
+    peak_L = std::max(peak_L, process_channel(left.subspan(offset, count), buffer_L));
+    peak_R = std::max(peak_R, process_channel(right.subspan(offset, count), buffer_R));
+  }
+}
+
+auto TruePeakDetector::process_channel(std::span<const float> input, std::vector<float>& buffer) -> float {
+  constexpr auto history = taps_per_phase - 1U;
+
+  const auto count = input.size();
+
+  std::copy(input.begin(), input.end(), buffer.begin() + history);
+
+  float peak = 0.0F;
+
+  for (uint p = 0U; p < factor; p++) {
+    const auto& phase = coefficients[p];
+
+    std::fill_n(phase_output.begin(), count, 0.0F);
+
+    for (uint k = 0U; k < taps_per_phase; k++) {
+      const auto c = phase[k];
+
+      const auto* x = buffer.data() + k;
+
+      auto* y = phase_output.data();
+
+      for (size_t n = 0U; n < count; n++) {
+        y[n] += c * x[n];
+      }
+    }
+
+    for (size_t n = 0U; n < count; n++) {
+      peak = std::max(peak, std::fabs(phase_output[n]));
+    }
+  }
+
+  // keeping the last samples for the next block
+
+  std::copy(buffer.begin() + static_cast<long>(count), buffer.begin() + static_cast<long>(count + history),
+            buffer.begin());
+
+  return peak;
+}
+
+auto TruePeakDetector::get_true_peak_left() const -> double {
+  return peak_L;
+}
+
+auto TruePeakDetector::get_true_peak_right() const -> double {
+  return peak_R;
+}
+
+auto TruePeakDetector::get_factor() const -> uint {
+  return factor;
+}
+
+auto TruePeakDetector::get_memory_usage() const -> size_t {
+  return util::container_bytes(buffer_L) + util::container_bytes(buffer_R) + util::container_bytes(phase_output);
+}
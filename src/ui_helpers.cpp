@@ -30,12 +30,19 @@
 #include <gtk/gtkshortcut.h>
 #include <sys/types.h>
 #include <algorithm>
+#include <cstdint>
 #include <locale>
 #include <map>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
+#include "node_info_holder.hpp"
+#include "pipe_manager.hpp"
+#include "pipe_objects.hpp"
 #include "tags_app.hpp"
+#include "tags_pipewire.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
 
@@ -278,6 +285,43 @@ void remove_from_string_list(GtkStringList* string_list, const std::string& name
   }
 }
 
+void setup_sidechain_sources(GListStore* model, PipeManager* pm, std::vector<sigc::connection>& connections) {
+  // the end of both effects pipelines. Our filters are not in the node map
+
+  for (const auto& [name, description] : {std::pair{tags::pipewire::ee_output_pipeline_end, _("Output Effects")},
+                                          std::pair{tags::pipewire::ee_input_pipeline_end, _("Input Effects")}}) {
+    auto* holder = ui::holders::create(NodeInfo{.name = name, .description = description});
+
+    g_list_store_append(model, holder);
+
+    g_object_unref(holder);
+  }
+
+  connections.push_back(pm->stream_output_added.connect([=](const NodeInfo info) {
+    auto* holder = ui::holders::create(info);
+
+    g_list_store_append(model, holder);
+
+    g_object_unref(holder);
+  }));
+
+  connections.push_back(pm->stream_output_removed.connect([=](const uint64_t serial) {
+    for (guint n = 0U; n < g_list_model_get_n_items(G_LIST_MODEL(model)); n++) {
+      auto* holder = static_cast<ui::holders::NodeInfoHolder*>(g_list_model_get_item(G_LIST_MODEL(model), n));
+
+      if (holder->info->serial == serial) {
+        g_list_store_remove(model, n);
+
+        g_object_unref(holder);
+
+        return;
+      }
+
+      g_object_unref(holder);
+    }
+  }));
+}
+
 void init_global_app_settings() {
   global_app_settings = g_settings_new(tags::app::id);
 }
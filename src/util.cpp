@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstring>
 #include <filesystem>
 #include <functional>
@@ -41,6 +42,7 @@
 #include <thread>
 #include <utility>
 #include <vector>
+#include "rt_checks.hpp"
 
 namespace util {
 
@@ -298,6 +300,8 @@ void remove_blocklist_entry(GSettings* settings, const std::string& name) {
 }
 
 void idle_add(std::function<void()> cb, std::function<void()> cleanup_cb) {
+  rt_checks::check("util::idle_add");
+
   struct Data {
     std::function<void()> cb, cleanup_cp;
   };
@@ -557,4 +561,37 @@ auto compare_versions(const std::string& v0, const std::string& v1) -> int {
   return 0;
 }
 
+auto zita_memory_usage(const uint& n_channels, const size_t& kernel_size, const uint& part_size) -> size_t {
+  if (part_size == 0U) {
+    return 0U;
+  }
+
+  /*
+    Estimate of what zita-convolver allocates. For each channel it keeps the impulse response and the history of the
+    input in the frequency domain. Both use part_size + 1 complex values per partition.
+  */
+
+  const size_t n_partitions = (kernel_size + part_size - 1U) / part_size;
+
+  const size_t complex_size = 2U * sizeof(float);
+
+  return static_cast<size_t>(n_channels) * 2U * n_partitions * (part_size + 1U) * complex_size;
+}
+
+auto format_bytes(const size_t& bytes) -> std::string {
+  constexpr double kib = 1024.0;
+
+  const auto value = static_cast<double>(bytes);
+
+  if (value < kib) {
+    return to_string(bytes) + " B";
+  }
+
+  if (value < kib * kib) {
+    return to_string(std::round(10.0 * value / kib) / 10.0, "") + " KiB";
+  }
+
+  return to_string(std::round(10.0 * value / (kib * kib)) / 10.0, "") + " MiB";
+}
+
 }  // namespace util
@@ -0,0 +1,123 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+  Checks TruePeakDetector against signals whose true peak is known, in the spirit of the true peak tests of EBU Tech
+  3341. A sine at a quarter of the rate with a phase of 45 degrees has its samples 3.01 dB below its true peak. The
+  readings have to be inside the tolerance of EBU Tech 3341, +0.2 dB and -0.4 dB.
+*/
+
+#include <sys/types.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <numbers>
+#include <span>
+#include <string>
+#include <vector>
+#include "true_peak_detector.hpp"
+
+namespace {
+
+constexpr uint block_size = 256U;
+
+struct TestCase {
+  std::string name;
+
+  uint rate;
+
+  double frequency, amplitude, phase;
+
+  uint factor;
+
+  double expected_db;
+};
+
+auto measure(const TestCase& test) -> double {
+  TruePeakDetector detector;
+
+  detector.setup(test.rate, block_size);
+
+  if (detector.get_factor() != test.factor) {
+    std::cerr << test.name << ": oversampling factor " << detector.get_factor() << ", expected " << test.factor
+              << '\n';
+
+    return 100.0;
+  }
+
+  // one second, so the filter history does not matter
+
+  std::vector<float> left(test.rate);
+  std::vector<float> right(test.rate);
+
+  for (size_t n = 0U; n < left.size(); n++) {
+    const auto t = static_cast<double>(n) / static_cast<double>(test.rate);
+
+    left[n] = static_cast<float>(test.amplitude * std::sin(2.0 * std::numbers::pi * test.frequency * t + test.phase));
+    right[n] = -left[n];
+  }
+
+  detector.process(std::span<const float>(left), std::span<const float>(right));
+
+  const auto left_db = 20.0 * std::log10(detector.get_true_peak_left());
+  const auto right_db = 20.0 * std::log10(detector.get_true_peak_right());
+
+  if (std::fabs(left_db - right_db) > 1e-6) {
+    std::cerr << test.name << ": the channels differ, " << left_db << " dB and " << right_db << " dB\n";
+
+    return 100.0;
+  }
+
+  return left_db;
+}
+
+}  // namespace
+
+auto main() -> int {
+  constexpr auto quarter_pi = 0.25 * std::numbers::pi;
+
+  const std::vector<TestCase> tests = {
+      {"48 kHz, 12 kHz at 45 degrees", 48000U, 12000.0, 1.0, quarter_pi, 4U, 0.0},
+      {"48 kHz, 997 Hz at -6.02 dB", 48000U, 997.0, 0.5, 0.0, 4U, -6.0206},
+      {"44.1 kHz, 11025 Hz at 45 degrees", 44100U, 11025.0, 1.0, quarter_pi, 4U, 0.0},
+      {"44.1 kHz, 11025 Hz at 45 degrees and -20 dB", 44100U, 11025.0, 0.1, quarter_pi, 4U, -20.0},
+      {"96 kHz, 24 kHz at 45 degrees", 96000U, 24000.0, 1.0, quarter_pi, 2U, 0.0},
+      {"192 kHz, 997 Hz", 192000U, 997.0, 1.0, 0.0, 1U, 0.0},
+  };
+
+  int failures = 0;
+
+  for (const auto& test : tests) {
+    const auto value = measure(test);
+
+    const auto error = value - test.expected_db;
+
+    const auto passed = error <= 0.2 && error >= -0.4;
+
+    std::cout << (passed ? "PASS " : "FAIL ") << test.name << ": " << value << " dBTP, expected " << test.expected_db
+              << " dBTP\n";
+
+    if (!passed) {
+      failures++;
+    }
+  }
+
+  return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,545 @@
+#!/usr/bin/env python3
+
+# Soak test for Easy Effects against a private PipeWire instance.
+#
+# A PipeWire daemon and a session manager are started inside a temporary XDG_RUNTIME_DIR so that the
+# user's session is never touched. A few fake output and input devices (null sinks/sources) are created,
+# Easy Effects is started as a service and then, for the requested duration, the script keeps spawning and
+# killing synthetic playback and capture streams while randomly loading presets, toggling the global bypass,
+# switching the default devices and forcing quantum changes.
+#
+# Every report interval one CSV line is written with the resident memory of Easy Effects, the accumulated
+# xruns of its filter nodes and the relink times measured since the previous line.
+#
+# Usage example (2 hours, 16 playback and 4 capture streams):
+#   ./util/soak_test.py --duration 7200 --playback 16 --capture 4 --csv /tmp/soak.csv
+#
+# Requirements: pipewire, wireplumber, pw-cli, pw-cat, pw-dump, pw-metadata, pw-top and an easyeffects binary.
+
+import argparse
+import json
+import math
+import os
+import random
+import shutil
+import signal
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+import wave
+
+EE_NODE_PREFIX = "ee_"
+EE_SINK_NAME = "easyeffects_sink"
+EE_SOURCE_NAME = "easyeffects_source"
+
+# Plugins implemented inside Easy Effects itself. Presets made only of them work even when no LV2 package is
+# installed in the machine running the soak test.
+NATIVE_OUTPUT_PLUGINS = ["autogain", "crossfeed", "crystalizer", "delay", "level_meter", "stereo_tools"]
+NATIVE_INPUT_PLUGINS = ["autogain", "rnnoise", "speex", "stereo_tools"]
+
+QUANTA = [64, 128, 256, 512, 1024, 2048]
+
+
+def log(msg):
+    print(f"[{time.strftime('%H:%M:%S')}] {msg}", file=sys.stderr, flush=True)
+
+
+class Environment:
+    def __init__(self, args):
+        self.args = args
+        self.tmp_dir = tempfile.mkdtemp(prefix="ee-soak-")
+        self.processes = []
+
+        self.env = dict(os.environ)
+        self.env["XDG_RUNTIME_DIR"] = os.path.join(self.tmp_dir, "runtime")
+        self.env["XDG_CONFIG_HOME"] = os.path.join(self.tmp_dir, "config")
+        self.env["XDG_STATE_HOME"] = os.path.join(self.tmp_dir, "state")
+        self.env["PIPEWIRE_RUNTIME_DIR"] = self.env["XDG_RUNTIME_DIR"]
+        self.env["GSETTINGS_BACKEND"] = "keyfile"
+        self.env.pop("PIPEWIRE_REMOTE", None)
+        self.env.pop("PULSE_SERVER", None)
+
+        if args.schema_dir:
+            self.env["GSETTINGS_SCHEMA_DIR"] = args.schema_dir
+
+        for key in ("XDG_RUNTIME_DIR", "XDG_CONFIG_HOME", "XDG_STATE_HOME"):
+            os.makedirs(self.env[key], mode=0o700, exist_ok=True)
+
+    def spawn(self, cmd, keep=True, **kwargs):
+        p = subprocess.Popen(cmd, env=self.env, stdin=subprocess.DEVNULL, stdout=subprocess.DEVNULL,
+                             stderr=subprocess.DEVNULL, **kwargs)
+
+        if keep:
+            self.processes.append(p)
+
+        return p
+
+    def run(self, cmd, timeout=10):
+        return subprocess.run(cmd, env=self.env, capture_output=True, text=True, timeout=timeout).stdout
+
+    def start_daemons(self):
+        self.spawn(["pipewire"])
+
+        self.wait_for(lambda: os.path.exists(os.path.join(self.env["XDG_RUNTIME_DIR"], "pipewire-0")), "pipewire")
+
+        self.spawn([self.args.session_manager])
+
+        time.sleep(1)
+
+    def wait_for(self, predicate, what, timeout=10.0):
+        deadline = time.monotonic() + timeout
+
+        while time.monotonic() < deadline:
+            if predicate():
+                return
+
+            time.sleep(0.05)
+
+        raise RuntimeError(f"timeout while waiting for {what}")
+
+    def cleanup(self):
+        for p in reversed(self.processes):
+            if p.poll() is None:
+                p.send_signal(signal.SIGTERM)
+
+                try:
+                    p.wait(timeout=5)
+                except subprocess.TimeoutExpired:
+                    p.kill()
+
+        if not self.args.keep_tmp:
+            shutil.rmtree(self.tmp_dir, ignore_errors=True)
+
+
+class Graph:
+    """Thin wrapper around pw-dump. The whole graph is parsed on each call, which is fine for polling."""
+
+    def __init__(self, environment):
+        self.environment = environment
+        self.objects = []
+
+    def refresh(self):
+        try:
+            self.objects = json.loads(self.environment.run(["pw-dump", "--no-colors"]) or "[]")
+        except (json.JSONDecodeError, subprocess.TimeoutExpired):
+            self.objects = []
+
+        return self
+
+    def nodes(self):
+        for o in self.objects:
+            if o.get("type") == "PipeWire:Interface:Node":
+                yield o["id"], o.get("info", {}).get("props", {})
+
+    def links(self):
+        for o in self.objects:
+            if o.get("type") == "PipeWire:Interface:Link":
+                info = o.get("info", {})
+
+                yield o["id"], info.get("output-node-id"), info.get("input-node-id"), info.get("state")
+
+    def node_id(self, name):
+        for node_id, props in self.nodes():
+            if props.get("node.name") == name:
+                return node_id
+
+        return None
+
+    def pipeline_links(self, pipeline, device_name):
+        """Links of a pipeline ("soe" or "sie") and whether its last node is fed and linked to the given device.
+
+        Only the links going into the filters of the pipeline and from its output level to the device are taken. The
+        links of the streams recording from the pipeline come and go with the stream churn. Bypassed plugins are not
+        linked at all, so the links of the plugins in between are not checked one by one.
+        """
+
+        nodes = {node_id for node_id, props in self.nodes()
+                 if props.get("node.name", "").startswith(EE_NODE_PREFIX + pipeline + "_")}
+
+        level_id = self.node_id(EE_NODE_PREFIX + pipeline + "_output_level")
+        device_id = self.node_id(device_name)
+
+        if level_id is None and pipeline == "sie":
+            # with the virtual source filter the output level of the input pipeline is the Easy Effects source itself
+            level_id, device_id = device_id, None
+
+            nodes.add(level_id)
+
+        links = list(self.links())
+
+        ids = frozenset(link_id for link_id, o, i, _ in links
+                        if i in nodes or (device_id is not None and o == level_id and i == device_id))
+
+        fed = any(i == level_id for _, _, i, _ in links)
+        linked = device_id is None or any(o == level_id and i == device_id for _, o, i, _ in links)
+
+        return ids, level_id is not None and fed and linked
+
+
+class SoakTest:
+    def __init__(self, args):
+        self.args = args
+        self.environment = Environment(args)
+        self.graph = Graph(self.environment)
+        self.rng = random.Random(args.seed)
+        self.easyeffects = None
+        self.streams = []
+        self.n_spawned = 0
+        self.sinks = [f"soak_sink_{n}" for n in range(args.devices)]
+        self.sources = [f"soak_source_{n}" for n in range(args.devices)]
+        self.current_sink = self.sinks[0]
+        self.relink_times = []
+        self.failed_relinks = 0
+        self.xruns_start = None
+        self.rss_start = None
+
+    # setup
+
+    def create_devices(self):
+        for name, media_class in [(s, "Audio/Sink") for s in self.sinks] + [(s, "Audio/Source/Virtual")
+                                                                           for s in self.sources]:
+            props = ("{ factory.name=support.null-audio-sink node.name=" + name + " media.class=" + media_class +
+                     " object.linger=true audio.position=[ FL FR ] monitor.channel-volumes=true }")
+
+            self.environment.run(["pw-cli", "create-node", "adapter", props])
+
+    def create_signal_file(self):
+        path = os.path.join(self.environment.tmp_dir, "signal.wav")
+        rate = 48000
+
+        with wave.open(path, "wb") as w:
+            w.setnchannels(2)
+            w.setsampwidth(2)
+            w.setframerate(rate)
+
+            frames = bytearray()
+
+            for n in range(rate * 30):
+                v = int(8000 * math.sin(2.0 * math.pi * 440.0 * n / rate))
+
+                frames += struct.pack("<hh", v, v)
+
+            w.writeframes(bytes(frames))
+
+        return path
+
+    def create_presets(self):
+        for preset_type, plugins in (("output", NATIVE_OUTPUT_PLUGINS), ("input", NATIVE_INPUT_PLUGINS)):
+            directory = os.path.join(self.environment.env["XDG_CONFIG_HOME"], "easyeffects", preset_type)
+
+            os.makedirs(directory, exist_ok=True)
+
+            for n in range(self.args.presets):
+                order = [p + "#0" for p in self.rng.sample(plugins, self.rng.randint(1, len(plugins)))]
+
+                preset = {preset_type: {"blocklist": [], "plugins_order": order}}
+
+                for p in order:
+                    preset[preset_type][p] = {"bypass": False}
+
+                with open(os.path.join(directory, f"soak_{preset_type}_{n}.json"), "w") as f:
+                    json.dump(preset, f, indent=4)
+
+    def start_easyeffects(self):
+        self.easyeffects = self.environment.spawn([self.args.easyeffects, "--gapplication-service"])
+
+        self.environment.wait_for(lambda: self.graph.refresh().node_id(EE_SINK_NAME) is not None,
+                                  "the Easy Effects sink", timeout=30.0)
+
+    def ee_command(self, *args):
+        self.environment.spawn([self.args.easyeffects, *args], keep=False).wait(timeout=10)
+
+    # actions
+
+    def spawn_stream(self, playback):
+        self.n_spawned += 1
+
+        if playback:
+            path = None
+            cmd = ["pw-cat", "--playback", "--media-role", self.rng.choice(["Music", "Game", "Communication"]),
+                   self.signal_file]
+        else:
+            # the recording is only used to keep the capture stream alive
+            path = os.path.join(self.environment.tmp_dir, f"rec{self.n_spawned}.wav")
+            cmd = ["pw-cat", "--record", path]
+
+        p = self.environment.spawn(cmd, keep=False)
+
+        lifetime = self.rng.uniform(self.args.min_lifetime, self.args.max_lifetime)
+
+        self.streams.append((p, time.monotonic() + lifetime, playback, path))
+
+    def churn_streams(self):
+        now = time.monotonic()
+        alive = []
+
+        for p, deadline, playback, path in self.streams:
+            if now >= deadline or p.poll() is not None:
+                if p.poll() is None:
+                    p.terminate()
+                    p.wait()
+
+                if path is not None and os.path.exists(path):
+                    os.remove(path)
+            else:
+                alive.append((p, deadline, playback, path))
+
+        self.streams = alive
+
+        n_playback = sum(1 for s in self.streams if s[2])
+        n_capture = len(self.streams) - n_playback
+
+        for _ in range(self.args.playback - n_playback):
+            self.spawn_stream(True)
+
+        for _ in range(self.args.capture - n_capture):
+            self.spawn_stream(False)
+
+    def measure_relink(self, action, description, pipeline="soe"):
+        # the output pipeline feeds the current device and the input pipeline feeds the Easy Effects source
+
+        device = self.current_sink if pipeline == "soe" else EE_SOURCE_NAME
+
+        old_links, _ = self.graph.refresh().pipeline_links(pipeline, device)
+
+        start = time.monotonic()
+
+        action()
+
+        # Depending on the action the whole pipeline is relinked, only the links around a few plugins are replaced or
+        # nothing changes at all. An idle pipeline is suspended and keeps its links. The relink is over when the links
+        # differ from the ones made before the action, the pipeline is complete and the links stay the same for two
+        # consecutive polls. The elapsed time is the one of the first of them.
+
+        deadline = start + self.args.relink_timeout
+
+        changed = False
+        candidate, candidate_time = None, 0.0
+
+        while time.monotonic() < deadline:
+            links, complete = self.graph.refresh().pipeline_links(pipeline, device)
+
+            now = time.monotonic()
+
+            changed = changed or links != old_links
+
+            if links != old_links and complete:
+                if links == candidate:
+                    elapsed = candidate_time - start
+
+                    self.relink_times.append(elapsed)
+
+                    log(f"{description}: relinked in {elapsed * 1000.0:.1f} ms")
+
+                    return
+
+                candidate, candidate_time = links, now
+            else:
+                candidate = None
+
+            time.sleep(0.02)
+
+        if not changed:
+            log(f"{description}: the links of the {pipeline} pipeline did not change")
+
+            return
+
+        self.failed_relinks += 1
+
+        log(f"{description}: the {pipeline} pipeline was not linked after {self.args.relink_timeout} s")
+
+    def load_random_preset(self):
+        preset_type = self.rng.choice(["output", "input"])
+        name = f"soak_{preset_type}_{self.rng.randrange(self.args.presets)}"
+
+        self.measure_relink(lambda: self.ee_command("-l", name), f"preset {name}",
+                            "soe" if preset_type == "output" else "sie")
+
+    def toggle_bypass(self):
+        self.measure_relink(lambda: self.ee_command("-b", "1"), "bypass on")
+        self.measure_relink(lambda: self.ee_command("-b", "2"), "bypass off")
+
+    def switch_default_devices(self):
+        self.current_sink = self.rng.choice(self.sinks)
+        source = self.rng.choice(self.sources)
+
+        def action():
+            for key, name in (("default.configured.audio.sink", self.current_sink),
+                              ("default.configured.audio.source", source)):
+                self.environment.run(["pw-metadata", "0", key, '{ "name": "' + name + '" }', "Spa:String:JSON"])
+
+        self.measure_relink(action, f"default devices {self.current_sink} / {source}")
+
+    def force_quantum(self):
+        quantum = self.rng.choice(QUANTA + [0])
+
+        self.environment.run(["pw-metadata", "-n", "settings", "0", "clock.force-quantum", str(quantum)])
+
+        log(f"forced quantum: {quantum if quantum else 'default'}")
+
+    # metrics
+
+    def ee_rss_kb(self):
+        try:
+            with open(f"/proc/{self.easyeffects.pid}/status") as f:
+                for line in f:
+                    if line.startswith("VmRSS:"):
+                        return int(line.split()[1])
+        except OSError:
+            pass
+
+        return -1
+
+    def ee_xruns(self):
+        """Sum of the ERR column reported by pw-top for our filter nodes and virtual devices."""
+
+        out = self.environment.run(["pw-top", "--batch-mode", "--iterations", "2"], timeout=15)
+
+        errors = {}
+
+        for line in out.splitlines():
+            fields = line.split()
+
+            if len(fields) < 10 or not fields[1].isdigit():
+                continue
+
+            name = fields[-1].lstrip("+ ")
+
+            if name.startswith(EE_NODE_PREFIX) or name in (EE_SINK_NAME, EE_SOURCE_NAME):
+                try:
+                    errors[name] = int(fields[8])
+                except ValueError:
+                    pass
+
+        return sum(errors.values())
+
+    def report(self, writer, elapsed):
+        rss = self.ee_rss_kb()
+        xruns = self.ee_xruns()
+
+        if self.rss_start is None:
+            self.rss_start, self.xruns_start = rss, xruns
+
+        times = sorted(self.relink_times) or [0.0]
+
+        line = [
+            f"{elapsed:.0f}",
+            str(len(self.streams)),
+            str(rss),
+            str(rss - self.rss_start),
+            str(xruns - self.xruns_start),
+            str(len(self.relink_times)),
+            str(self.failed_relinks),
+            f"{1000.0 * times[len(times) // 2]:.1f}",
+            f"{1000.0 * times[min(len(times) - 1, int(0.95 * len(times)))]:.1f}",
+            f"{1000.0 * times[-1]:.1f}",
+        ]
+
+        writer.write(",".join(line) + "\n")
+        writer.flush()
+
+        self.relink_times.clear()
+        self.failed_relinks = 0
+
+    # main loop
+
+    def run(self):
+        actions = [
+            (self.args.preset_weight, self.load_random_preset),
+            (self.args.bypass_weight, self.toggle_bypass),
+            (self.args.device_weight, self.switch_default_devices),
+            (self.args.quantum_weight, self.force_quantum),
+        ]
+
+        actions = [(w, a) for w, a in actions if w > 0]
+
+        self.environment.start_daemons()
+        self.create_devices()
+        self.create_presets()
+        self.signal_file = self.create_signal_file()
+        self.start_easyeffects()
+
+        writer = open(self.args.csv, "w") if self.args.csv else sys.stdout
+
+        writer.write("elapsed_s,streams,rss_kb,rss_growth_kb,xruns,relinks,failed_relinks,"
+                     "relink_p50_ms,relink_p95_ms,relink_max_ms\n")
+
+        start = time.monotonic()
+        next_report = start
+        next_action = start + self.args.action_interval
+
+        try:
+            while time.monotonic() - start < self.args.duration:
+                if self.easyeffects.poll() is not None:
+                    log(f"easyeffects exited with code {self.easyeffects.returncode}")
+
+                    return 1
+
+                self.churn_streams()
+
+                now = time.monotonic()
+
+                if now >= next_action and actions:
+                    weights, callables = zip(*actions)
+
+                    self.rng.choices(callables, weights=weights)[0]()
+
+                    next_action = time.monotonic() + self.rng.expovariate(1.0 / self.args.action_interval)
+
+                if now >= next_report:
+                    self.report(writer, now - start)
+
+                    next_report = now + self.args.report_interval
+
+                time.sleep(0.1)
+        finally:
+            for p, _, _, _ in self.streams:
+                if p.poll() is None:
+                    p.terminate()
+
+            self.ee_command("-q")
+
+            if writer is not sys.stdout:
+                writer.close()
+
+        return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Easy Effects soak test against a private PipeWire instance")
+
+    parser.add_argument("--easyeffects", default="easyeffects", help="binary to test")
+    parser.add_argument("--schema-dir", default=None, help="GSETTINGS_SCHEMA_DIR for uninstalled builds")
+    parser.add_argument("--session-manager", default="wireplumber")
+    parser.add_argument("--duration", type=float, default=3600.0, help="seconds")
+    parser.add_argument("--playback", type=int, default=8, help="number of simultaneous playback streams")
+    parser.add_argument("--capture", type=int, default=2, help="number of simultaneous capture streams")
+    parser.add_argument("--devices", type=int, default=2, help="number of fake output and input devices")
+    parser.add_argument("--presets", type=int, default=4, help="number of generated presets per pipeline")
+    parser.add_argument("--min-lifetime", type=float, default=2.0, help="minimum stream lifetime in seconds")
+    parser.add_argument("--max-lifetime", type=float, default=60.0, help="maximum stream lifetime in seconds")
+    parser.add_argument("--action-interval", type=float, default=5.0, help="mean seconds between actions")
+    parser.add_argument("--preset-weight", type=float, default=4.0)
+    parser.add_argument("--bypass-weight", type=float, default=2.0)
+    parser.add_argument("--device-weight", type=float, default=1.0)
+    parser.add_argument("--quantum-weight", type=float, default=1.0)
+    parser.add_argument("--relink-timeout", type=float, default=10.0, help="seconds")
+    parser.add_argument("--report-interval", type=float, default=60.0, help="seconds")
+    parser.add_argument("--csv", default=None, help="write the report to this file instead of stdout")
+    parser.add_argument("--seed", type=int, default=None)
+    parser.add_argument("--keep-tmp", action="store_true", help="do not remove the temporary directory")
+
+    args = parser.parse_args()
+
+    test = SoakTest(args)
+
+    try:
+        return test.run()
+    finally:
+        test.environment.cleanup()
+
+
+if __name__ == "__main__":
+    sys.exit(main())